@@ -2,12 +2,21 @@
 #define BUTTON_H
 
 #include <Arduino.h>
+#include <esp_timer.h>
+#include <atomic>
 
 // Button timing constants
 #define DEBOUNCE_DELAY 50          // ms
 #define SHORT_PRESS_MAX 1000       // ms
 #define LONG_PRESS_MIN 3000        // ms
 #define FACTORY_RESET_MIN 10000    // ms
+#define DOUBLE_TAP_WINDOW 300      // ms after a tap to wait for a second one
+#define HOLD_REPEAT_DELAY 500      // ms the second tap is held before repeating
+#define HOLD_REPEAT_INTERVAL 400   // ms between repeats
+
+// Sampling runs from an esp_timer so presses are measured even while loop() blocks
+#define BUTTON_SAMPLE_INTERVAL_US 5000  // 5 ms
+#define BUTTON_QUEUE_SIZE 8             // Event ring slots (power of two)
 
 // Capacitive touch settings
 #define TOUCH_THRESHOLD_RATIO 0.7  // 70% of baseline is considered a touch
@@ -17,16 +26,62 @@ enum ButtonEvent {
     NONE,
     SHORT_PRESS,    // < 1s: Cycle to next module
     LONG_PRESS,     // 3-10s: Enter config mode
-    FACTORY_RESET   // 10s+: Clear all settings
+    FACTORY_RESET,  // 10s+: Clear all settings
+    DOUBLE_TAP,     // Two taps: Back to previous module
+    REPEAT_PRESS    // Tap, then hold: Cycle forward every HOLD_REPEAT_INTERVAL
+};
+
+// Gesture recognizer phases
+enum GesturePhase {
+    GESTURE_IDLE,
+    GESTURE_FIRST_DOWN,   // First press held (tap, or hold toward setup/reset)
+    GESTURE_WAIT_SECOND,  // Tap released, waiting DOUBLE_TAP_WINDOW
+    GESTURE_SECOND_DOWN,  // Second press held (double tap, or start of repeat)
+    GESTURE_REPEATING     // Auto-repeat until release
+};
+
+// Recognizer state; only touched by recognizeGesture()
+struct GestureState {
+    GesturePhase phase;
+    bool lastSample;          // Raw level of the previous sample
+    bool pressed;             // Debounced level
+    uint32_t lastChange;      // Time of the last raw level change
+    uint32_t pressStart;      // Debounced press edge
+    uint32_t releaseTime;     // Debounced release edge of the first tap
+    uint32_t nextRepeat;
+};
+
+// Advance the recognizer by one raw sample. A pure function of the sample
+// levels and timestamps, so sequences can be replayed on the host.
+// Returns the event completed by this sample (NONE for most samples);
+// duration receives the press length for the returned event.
+ButtonEvent recognizeGesture(GestureState& state, bool touched, uint32_t now, uint32_t& duration);
+
+// A classified press, timestamped by the sampler
+struct ButtonEventRecord {
+    ButtonEvent type;
+    uint32_t time;       // millis() at release
+    uint32_t duration;   // Press length in ms
 };
 
 class ButtonHandler {
 private:
     uint8_t pin;
-    bool lastState;
-    unsigned long pressStartTime;
-    unsigned long lastDebounceTime;
-    bool isPressed;
+
+    // Gesture state, owned by the sampler; the hold start is mirrored for loop()
+    GestureState gesture;
+    volatile bool isHolding;
+    volatile uint32_t holdStartTime;
+
+    // Single-producer (sampler) / single-consumer (loop) event ring
+    ButtonEventRecord queue[BUTTON_QUEUE_SIZE];
+    std::atomic<uint8_t> queueHead;   // Next slot the sampler writes
+    std::atomic<uint8_t> queueTail;   // Next slot check() reads
+    volatile uint32_t droppedEvents;
+
+    esp_timer_handle_t sampleTimer;
+    static void onSampleTimer(void* arg);
+    void pushEvent(ButtonEvent type, uint32_t now, uint32_t duration);
 
     // Capacitive touch
     uint16_t touchBaseline;
@@ -40,9 +95,20 @@ public:
     ButtonHandler(uint8_t buttonPin, bool capacitiveTouch = true);
 
     void init();
+
+    // Feed one pin sample; called by the timer (or directly with synthetic input)
+    void sample(bool touched, uint32_t now);
+
+    // Pop the oldest queued event; false if none
+    bool nextEvent(ButtonEventRecord& event);
+
+    // Next queued event, or NONE (called from loop())
     ButtonEvent check();
+
+    // First press still held (the one that can become LONG_PRESS/FACTORY_RESET)
     bool isCurrentlyPressed();
     unsigned long getCurrentPressDuration();
+    uint32_t getDroppedEvents() { return droppedEvents; }
 };
 
 #endif // BUTTON_H
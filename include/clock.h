@@ -0,0 +1,37 @@
+#ifndef CLOCK_H
+#define CLOCK_H
+
+#include <Arduino.h>
+
+// Monotonic time since boot. millis() is 32 bits and wraps after ~49.7 days;
+// these extend it to 64 bits so stored timestamps and deadlines can be
+// compared directly for the life of the device.
+#define TIME_NEVER UINT64_MAX   // Timestamp of something that has not happened
+
+// uptimeSeconds() starts at this rather than 0, leaving room below boot for
+// readings restored from before a reboot (see syncCacheTimestamps())
+#define UPTIME_SECONDS_BASE 0x100000000ULL
+
+uint64_t uptimeMillis();
+uint64_t uptimeSeconds();
+
+// Time between a timestamp and now, in the timestamp's units.
+// TIME_NEVER if it never happened; 0 if the timestamp is in the future.
+uint64_t timeSince(uint64_t then, uint64_t now);
+
+// True once a deadline has passed (TIME_NEVER never passes)
+inline bool timeReached(uint64_t deadline, uint64_t now) {
+    return deadline != TIME_NEVER && now >= deadline;
+}
+
+// Wall clock, set by SNTP once WiFi is up. Only used to date readings that
+// outlive a reboot; scheduling stays on the monotonic clock.
+#define NTP_SERVER_1 "pool.ntp.org"
+#define NTP_SERVER_2 "time.google.com"
+#define WALL_CLOCK_MIN 1700000000UL   // Anything earlier is an unset RTC
+
+void startWallClock();       // Call once WiFi connects
+bool wallClockValid();
+uint32_t wallClockSeconds(); // Unix time (UTC), 0 until the first sync
+
+#endif // CLOCK_H
@@ -4,12 +4,23 @@
 #include <Arduino.h>
 #include <ArduinoJson.h>
 #include <LittleFS.h>
+#include "clock.h"
+#include "module_registry.h"
 
-// Configuration file path
-#define CONFIG_FILE "/config.json"
+// Configuration file path (durable settings only, saved on change)
+#define CONFIG_FILE "/config.bin"            // Versioned header + MessagePack
+#define CONFIG_TMP_FILE "/config.bin.tmp"    // Written first, then renamed over CONFIG_FILE
+#define CONFIG_IMPORT_FILE "/config.json"    // Imported once at boot if present, then removed
+#define CONFIG_SCHEMA_VERSION 2              // Bump and add a migration in config.cpp on layout changes
+
+// Module readings snapshot (binary, written at most every 15 minutes)
+#define CACHE_FILE "/cache.bin"
+#define CACHE_TMP_FILE "/cache.bin.tmp"
+#define CACHE_SNAPSHOT_INTERVAL 900000
+#define CACHE_RESTORE_TIMEOUT 30000  // ms after boot to wait for the wall clock to date restored readings
 
 // Global configuration document (StaticJsonDocument allocated in .bss, not heap)
-// Increased to 2KB to accommodate all crypto fields
+// Holds settings only; live readings are in moduleCache
 extern StaticJsonDocument<2048> config;
 
 // Configuration management functions
@@ -18,12 +29,67 @@ bool loadConfiguration();
 bool saveConfiguration(bool force = false);
 void setDefaultConfig();
 
+// Module cache slots (one fixed record per module with live data). A
+// module's slot is its ModuleId, so cached modules lead the registry.
+enum ModuleSlot {
+    SLOT_BITCOIN = MODULE_BITCOIN,
+    SLOT_ETHEREUM = MODULE_ETHEREUM,
+    SLOT_STOCK = MODULE_STOCK,
+    SLOT_WEATHER = MODULE_WEATHER,
+    SLOT_CUSTOM = MODULE_CUSTOM,
+    MODULE_SLOT_COUNT
+};
+
+static_assert(SLOT_BITCOIN == 0 && SLOT_ETHEREUM == 1 && SLOT_STOCK == 2 &&
+              SLOT_WEATHER == 3 && SLOT_CUSTOM == 4, "cached modules must lead MODULE_REGISTRY");
+
+#define CACHE_DETAIL_LEN 16
+#define CACHE_LABEL_LEN 24
+#define CACHE_UNIT_LEN 12
+
+// Live readings plus the labels needed to draw them. Modules write their
+// record after a fetch and the display reads it every frame; the JSON config
+// only supplies the labels.
+struct ModuleCacheEntry {
+    float value;                      // Price, temperature or custom value
+    float change;                     // Percent change (24h crypto, daily stock)
+    uint64_t lastUpdate;              // uptimeSeconds() of the last update (TIME_NEVER = never)
+    uint32_t updatedAt;               // Unix time of the last update (0 = wall clock not synced yet)
+    bool lastSuccess;
+    char detail[CACHE_DETAIL_LEN];    // Weather condition
+    char label[CACHE_LABEL_LEN];      // Crypto name, ticker, location or custom label
+    char unit[CACHE_UNIT_LEN];        // Custom unit
+};
+
+extern ModuleCacheEntry moduleCache[MODULE_SLOT_COUNT];
+
+// Order the button cycles through (settings second for easier access);
+// the scheduler prefetches the module after the active one
+#define MODULE_CYCLE_COUNT 6
+extern const ModuleId moduleCycleOrder[MODULE_CYCLE_COUNT];
+
+// Module shown on the display (device.activeModule, bitcoin if unknown)
+ModuleId getActiveModule();
+void setActiveModule(ModuleId id);
+JsonObject moduleConfig(ModuleId id);  // config["modules"][name], created if missing
+
 // Module cache functions
-void updateModuleCache(const char* moduleId, JsonObject data);
-bool isCacheStale(const char* moduleId);
-unsigned long getCacheAge(const char* moduleId);
+ModuleCacheEntry* getModuleCache(ModuleId id);  // nullptr if the module has no cache record
+void loadModuleLabels();                 // Labels from settings (after config load/change)
+bool stripReadings();                    // Drop legacy readings from config; true if any
+void exportModuleCache(JsonObject out);  // Readings as JSON for dumps and the API
+bool loadCacheSnapshot();
+void syncCacheTimestamps();              // Match up uptime and Unix stamps once the wall clock syncs
+bool cacheRestorePending();              // Restored readings still waiting for the wall clock
+void stampModuleCache(ModuleCacheEntry& entry);  // Mark a reading as fetched now
+bool saveCacheSnapshot(bool force = false);
+void clearModuleCache(ModuleSlot slot);
+bool isCacheStale(ModuleId id);
+uint64_t getCacheAge(ModuleId id);  // Seconds (TIME_NEVER if never updated)
 
 // Helper functions
-String getTimeAgo(unsigned long timestamp);
+// "5m ago" / "Never" into out; fits in TIME_AGO_LEN
+#define TIME_AGO_LEN 12
+const char* formatTimeAgo(uint64_t timestamp, char* out, size_t len);
 
 #endif // CONFIG_H
@@ -5,6 +5,51 @@
 #include <U8g2lib.h>
 #include <Wire.h>
 #include <qrcode.h>
+#include "module_registry.h"
+
+// SH1106 frame geometry in 8x8 tiles (one tile row = one controller page)
+#define DISPLAY_TILE_COLS 16
+#define DISPLAY_TILE_ROWS 8
+#define DISPLAY_BUFFER_SIZE (DISPLAY_TILE_COLS * DISPLAY_TILE_ROWS * 8)
+
+// Module screen layout (templates are declared per cache slot in display.cpp)
+struct ScreenTemplate;
+struct ModuleCacheEntry;
+
+// Centered text line whose width is measured only when its text or font changes
+struct LayoutText {
+    const uint8_t* font;
+    char text[24];
+    u8g2_uint_t width;
+};
+
+enum LayoutTextRole {
+    LAYOUT_VALUE,     // Big value
+    LAYOUT_SUBLINE,   // Change, condition or unit
+    LAYOUT_FOOTER,    // Second line (weather location)
+    LAYOUT_TEXT_COUNT
+};
+
+// Config-mode QR codes: version 3 (29x29 modules) at 2 px per module
+#define QR_VERSION 3
+#define QR_SCALE 2
+#define QR_PIXELS ((4 * QR_VERSION + 17) * QR_SCALE)
+#define QR_XBM_SIZE (((QR_PIXELS + 7) / 8) * QR_PIXELS)
+
+#define QR_MAX_PAYLOAD 53  // Byte capacity of version 3 at ECC_LOW
+
+// Encoded QR code as an XBM bitmap, kept until its payload changes
+struct QRBitmap {
+    bool valid;
+    char payload[QR_MAX_PAYLOAD + 1];
+    uint8_t bits[QR_XBM_SIZE];
+};
+
+enum QRSlot {
+    QR_WIFI,   // Join the setup access point
+    QR_URL,    // Open the setup page
+    QR_SLOT_COUNT
+};
 
 // Display states
 enum DisplayState {
@@ -21,23 +66,51 @@ enum ConfigQRState {
     CLIENT_CONNECTED      // Show URL QR
 };
 
+// Frame transfer counters (a tile is 8 bytes on the I2C bus)
+struct DisplayStats {
+    uint32_t frames;       // Frames flushed
+    uint32_t skipped;      // Module frames not rebuilt because nothing visible changed
+    uint32_t fullFrames;   // Frames sent whole (first frame after init)
+    uint32_t tilesSent;    // Tiles pushed, full frames included
+    uint32_t textMeasures; // getStrWidth() calls for module screen text
+};
+
 class DisplayManager {
 private:
     U8G2_SH1106_128X64_NONAME_F_HW_I2C u8g2;
     DisplayState currentState;
 
+    // Copy of what the panel shows, to send only tiles that changed
+    uint8_t lastFrame[DISPLAY_BUFFER_SIZE];
+    bool frameValid;
+    DisplayStats stats;
+
+    // Hash of the inputs behind the module screen on the panel (0 = other screen)
+    uint32_t renderKey;
+
+    void flush();
+
+    // Module screen rendering from a template and the cached reading
+    LayoutText layoutText[LAYOUT_TEXT_COUNT];
+    u8g2_uint_t measureText(LayoutText& cached, const char* text, const uint8_t* font);
+    void drawLayoutLine(LayoutText& cached, const char* text, int y, const uint8_t* font);
+    void renderModule(const ScreenTemplate& layout, const ModuleCacheEntry& entry, const char* timeAgo, bool stale);
+
+    QRBitmap qrCache[QR_SLOT_COUNT];
+
     // Helper drawing functions
     void drawCenteredText(const char* text, int y, const uint8_t* font);
     void drawCenteredValue(const char* value, int y);
-    void drawStatusBar(bool wifiConnected, unsigned long lastUpdate, bool isStale);
+    void drawStatusBar(bool wifiConnected, const char* timeAgo, bool isStale);
     void drawHeader(const char* title);
-    void drawQRCode(const char* data, int x, int y, int scale);
+    void drawQRCode(QRSlot slot, const char* data, int x, int y);
 
 public:
     DisplayManager();
 
     void init();
     void clear();
+    const DisplayStats& getStats() const { return stats; }
 
     // State-specific display functions
     void showSplash();
@@ -45,15 +118,8 @@ public:
     void showConfigMode(const char* apName);
     void showError(const char* message);
 
-    // Module-specific display functions
-    void showBitcoin(float price, float change24h, unsigned long lastUpdate, bool stale);
-    void showEthereum(float price, float change24h, unsigned long lastUpdate, bool stale);
-    void showStock(const char* ticker, float price, float change, unsigned long lastUpdate, bool stale);
-    void showWeather(float temp, const char* condition, const char* location, unsigned long lastUpdate, bool stale);
-    void showCustom(float value, const char* label, const char* unit, unsigned long lastUpdate);
-
-    // Generic module display
-    void showModule(const char* moduleId);
+    // Module screen, drawn from the slot's template
+    void showModule(ModuleId id);
 
     // Button debug
     void showButtonStatus(bool isPressed, int digitalValue, int analogValue);
@@ -66,6 +132,9 @@ public:
 
     // Loading state with progress bar
     void showModuleLoading(const char* moduleName, int progress);
+
+    // Button held toward a long-press action
+    void showHoldProgress(const char* action, const char* hint, int progress);
 };
 
 #endif // DISPLAY_H
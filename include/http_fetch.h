@@ -0,0 +1,140 @@
+#ifndef HTTP_FETCH_H
+#define HTTP_FETCH_H
+
+#include <Arduino.h>
+#include <WiFiClientSecure.h>
+#include <atomic>
+
+// Fetch timing constants
+#define FETCH_TIMEOUT_MS 15000     // Whole request, connect to last byte
+#define FETCH_SLICE_MS 10          // Max time spent per poll()
+#define FETCH_READ_CHUNK 256       // Bytes copied per socket read
+
+// Every request gets its own connection and a full TLS handshake. Keeping
+// connections alive does not pay off: refreshes are minutes apart, servers
+// drop idle connections long before that, and the crypto modules already
+// share one request. TLS session resumption would be the fix, but
+// WiFiClientSecure has no way to carry a session over to a new connection.
+
+// Socket work that blocks runs on short-lived tasks: DNS, TCP connect and
+// the TLS handshake (up to a second) on the connect task, and the body,
+// which is handed to the BodyReader as it arrives, on the body task. Both
+// run below the loop task, so they only get the time loop() spends in
+// delay(). Their stacks are only held while they run.
+#define HTTP_CONNECT_STACK 8192    // mbedTLS handshake needs about as much as loop()
+#define HTTP_BODY_STACK 4096       // The reader (a filtered deserializeJson) plus a read buffer
+#define HTTP_TASK_PRIORITY tskIDLE_PRIORITY
+#define HTTP_MAX_HOST_LEN 64
+
+// Fetch states (advanced one slice at a time by poll())
+enum FetchState {
+    FETCH_IDLE,          // No request
+    FETCH_CONNECTING,    // TCP connect + TLS handshake (on the connect task)
+    FETCH_SENDING,       // Writing request line and headers
+    FETCH_STATUS,        // Waiting for "HTTP/1.1 200 OK"
+    FETCH_HEADERS,       // Reading response headers
+    FETCH_BODY,          // Body streaming into the reader (on the body task)
+    FETCH_DONE,          // Response complete (check getStatusCode())
+    FETCH_FAILED         // Connection/protocol error or timeout
+};
+
+// Cumulative transfer counters
+struct FetchStats {
+    uint32_t requests;
+    uint32_t handshakes;         // New TCP + TLS connections
+    uint32_t bytesSent;          // HTTP bytes (TLS record overhead not visible)
+    uint32_t bytesReceived;      // HTTP bytes including headers
+    uint32_t lastRequestBytes;   // Sent + received for the most recent request
+    uint32_t statusClasses[6];   // Complete responses by status class: [2] = 2xx ... [5] = 5xx, [0] = out of range
+    uint32_t failures;           // Timeouts, connection and protocol errors
+};
+
+// Reads a response body on the body task. read() on `body` waits for data
+// and returns -1 once the body has ended (or the request timed out).
+typedef void (*BodyReader)(Stream& body, void* arg);
+
+// Incremental HTTP(S) GET. begin() only records the request; every poll()
+// does a bounded amount of work so loop() keeps running while the response
+// trickles in. A 2xx body is streamed to the reader given to begin() and
+// never held in memory as a whole; other bodies are skipped.
+class HttpFetch {
+private:
+    friend class HttpBodyStream;
+
+    WiFiClientSecure* client;
+    FetchState state;
+    FetchStats stats;
+
+    // Request
+    String host;
+    String path;
+    uint16_t port;
+    uint32_t startTime;
+    BodyReader reader;
+    void* readerArg;
+
+    // Connect in progress on the connect task. The client belongs to the
+    // task until it posts a result; a request that gives up first (abort,
+    // timeout) leaves it to connectRunning() to close.
+    bool connecting;
+    bool connectAbandoned;
+    char connectHost[HTTP_MAX_HOST_LEN];
+    uint16_t connectPort;
+    std::atomic<uint8_t> connectResult;
+
+    // Body in progress on the body task, which owns the client and the
+    // chunk decoder until it posts a result. It stops at its next read once
+    // asked to, so abort() waits for it.
+    std::atomic<uint8_t> bodyResult;
+    std::atomic<bool> bodyCancelled;
+    const char* bodyError;   // Why the body could not be read to its end
+    bool bodyEnded;
+    long bodyBytes;          // Body bytes passed to the reader
+    uint32_t bodyReceived;   // Socket bytes read by the body task
+
+    // Response
+    uint32_t requestBytes;
+    uint32_t responseBytes;
+    int statusCode;
+    long contentLength;      // -1 when not sent
+    bool chunked;
+    long chunkRemaining;     // Bytes left in chunk, or a CHUNK_* marker
+    long retryAfter;         // Retry-After seconds, -1 when not sent
+    String line;             // Partial status/header/chunk-size line
+    String error;
+
+    bool parseUrl(const char* url);
+    bool readLine();
+    void handleHeader();
+    size_t decodeBody(uint8_t* data, size_t len);
+    size_t readBody(uint8_t* buffer, size_t size);
+    bool startBody();
+    static void bodyTask(void* arg);
+    void stopBody();
+    bool startConnect();
+    bool connectRunning();
+    static void connectTask(void* arg);
+    void closeClient();
+    void fail(const char* message);
+    void finish();
+
+public:
+    HttpFetch();
+    ~HttpFetch();
+
+    bool begin(const char* url, BodyReader reader = nullptr, void* readerArg = nullptr);
+    FetchState poll(uint16_t budgetMs = FETCH_SLICE_MS);
+    void abort();
+    void closeAbandoned();
+
+    bool isBusy() { return state != FETCH_IDLE && state != FETCH_DONE && state != FETCH_FAILED; }
+    FetchState getState() { return state; }
+    int getStatusCode() { return statusCode; }
+    long getRetryAfter() { return retryAfter; }
+    const String& getHost() { return host; }
+    const String& getError() { return error; }
+    uint32_t getElapsed() { return millis() - startTime; }
+    const FetchStats& getStats() { return stats; }
+};
+
+#endif // HTTP_FETCH_H
@@ -0,0 +1,42 @@
+#ifndef MEMSTATS_H
+#define MEMSTATS_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+
+// Heap and loop-task stack telemetry, sampled after each loop() stage and
+// while a fetch is in flight. Worst values are kept since boot so a device
+// that is slowly fragmenting shows it before it resets.
+
+enum MemStage : uint8_t {
+    MEM_STAGE_BUTTON,      // Button polling and hold preview
+    MEM_STAGE_WEB,         // WiFi reconnect and web server requests
+    MEM_STAGE_SCHEDULER,   // Refresh decisions (fetch slices are MEM_STAGE_FETCH)
+    MEM_STAGE_SNAPSHOT,    // Cache snapshot to flash
+    MEM_STAGE_DISPLAY,     // Screen render and transfer
+    MEM_STAGE_FETCH,       // TLS client alive, response being parsed
+    MEM_STAGE_COUNT
+};
+
+struct MemSample {
+    uint32_t freeHeap;      // Bytes
+    uint32_t largestBlock;  // Largest single allocation possible, bytes (see memSample())
+    uint32_t stackFree;     // Loop task stack never touched since boot, bytes
+};
+
+struct MemStageStats {
+    uint32_t samples;
+    MemSample last;
+    MemSample worst;        // Field-wise minimum since boot
+};
+
+void memSample(MemStage stage);
+MemSample memNow();
+uint32_t memMinFreeHeap();  // Lowest free heap since boot, any task
+const MemStageStats& memStageStats(MemStage stage);
+const char* memStageName(MemStage stage);
+
+// Current values, heap minimum and per-stage stats for /api/mem
+void exportMemStats(JsonObject out);
+
+#endif // MEMSTATS_H
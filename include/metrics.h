@@ -0,0 +1,38 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <Arduino.h>
+#include <WebServer.h>
+
+// Prometheus text exposition (format 0.0.4) for /metrics. The body is
+// streamed as chunked transfer from a small fixed buffer, so its size
+// does not depend on free heap.
+#define METRICS_CHUNK_SIZE 512
+#define METRICS_PREFIX "datatracker_"
+
+class MetricsWriter {
+private:
+    WebServer& server;
+    char buffer[METRICS_CHUNK_SIZE];
+    size_t used;
+
+    void append(const char* text, size_t len);
+    void appendf(const char* format, ...);
+    void flush();
+
+public:
+    explicit MetricsWriter(WebServer& server);   // Sends the status line and headers
+
+    // "# HELP" and "# TYPE" lines; name without METRICS_PREFIX
+    void family(const char* name, const char* type, const char* help);
+    // One sample, optionally with a single label (labelValue is not escaped)
+    void sample(const char* name, double value);
+    void sample(const char* name, const char* label, const char* labelValue, double value);
+
+    void finish();   // Sends what is buffered and ends the response
+};
+
+// Fetch, HTTP, scheduler, heap, display and WiFi metrics
+void writeMetrics(MetricsWriter& out);
+
+#endif // METRICS_H
@@ -0,0 +1,57 @@
+#ifndef MODULE_REGISTRY_H
+#define MODULE_REGISTRY_H
+
+#include <Arduino.h>
+
+// Every module, declared once: enum suffix, config/API id, class.
+// Modules with a cache record come first, in ModuleSlot order (config.h
+// checks this). Adding a module is one line here plus its class in
+// src/modules/, #included by main.cpp.
+#define MODULE_REGISTRY(X)                   \
+    X(BITCOIN,  "bitcoin",  BitcoinModule)   \
+    X(ETHEREUM, "ethereum", EthereumModule)  \
+    X(STOCK,    "stock",    StockModule)     \
+    X(WEATHER,  "weather",  WeatherModule)   \
+    X(CUSTOM,   "custom",   CustomModule)    \
+    X(SETTINGS, "settings", SettingsModule)
+
+// Dense module ids, usable as table indexes
+enum ModuleId : uint8_t {
+#define MODULE_ENUM(name, id, type) MODULE_##name,
+    MODULE_REGISTRY(MODULE_ENUM)
+#undef MODULE_ENUM
+    MODULE_COUNT,
+    MODULE_NONE = 0xFF
+};
+
+static constexpr const char* moduleNames[MODULE_COUNT] = {
+#define MODULE_NAME(name, id, type) id,
+    MODULE_REGISTRY(MODULE_NAME)
+#undef MODULE_NAME
+};
+
+// Compile-time name lookup, for literals: moduleIdOf("stock") == MODULE_STOCK
+constexpr bool moduleNameEquals(const char* a, const char* b) {
+    return *a == *b && (*a == '\0' || moduleNameEquals(a + 1, b + 1));
+}
+
+constexpr ModuleId moduleIdOf(const char* name, uint8_t i = 0) {
+    return i >= MODULE_COUNT ? MODULE_NONE
+         : moduleNameEquals(moduleNames[i], name) ? (ModuleId)i
+         : moduleIdOf(name, i + 1);
+}
+
+inline const char* moduleName(ModuleId id) {
+    return id < MODULE_COUNT ? moduleNames[id] : "none";
+}
+
+// Runtime lookup for names from config and the web UI (MODULE_NONE if unknown)
+inline ModuleId findModule(const char* name) {
+    return name ? moduleIdOf(name) : MODULE_NONE;
+}
+
+// Module instances indexed by ModuleId (defined in main.cpp)
+class ModuleInterface;
+extern ModuleInterface* const moduleTable[MODULE_COUNT];
+
+#endif // MODULE_REGISTRY_H
@@ -6,6 +6,7 @@
 #include <WiFiClientSecure.h>
 #include <HTTPClient.h>
 #include <WebServer.h>
+#include "clock.h"
 
 class NetworkManager {
 private:
@@ -15,11 +16,11 @@ private:
     String animalName;
     bool isAPMode;
     bool isSettingsMode;  // True when running settings web server
-    unsigned long lastReconnectAttempt;
+    uint64_t lastReconnectAttempt;      // uptimeMillis()
 
     // WiFi scan caching
     String cachedScanResults;
-    unsigned long lastScanTime;
+    uint64_t lastScanTime;              // uptimeMillis() when the last scan started or finished
     bool scanInProgress;
 
     // Client connection tracking
@@ -38,6 +39,7 @@ private:
     void handleGetConfig();
     void handleUpdateConfig();
     void handleStockSearch();
+    void handleMemStats();
     void handleRestart();
     void handleFactoryReset();
 
@@ -66,9 +68,6 @@ public:
     void stopSettingsServer();
     bool isSettingsServerRunning();
 
-    // HTTP requests
-    bool httpGet(const char* url, String& response, String& errorMsg);
-
     // Accessors
     String getAPName() { return apName; }
     String getAPPassword() { return apPassword; }
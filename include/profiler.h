@@ -0,0 +1,43 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <Arduino.h>
+
+// Per-stage timing of loop(), from the CPU cycle counter. Each stage is
+// timed from the previous perfLap() (or perfBeginLoop()) to its own, so
+// a lap costs one counter read. Durations go into log2 microsecond
+// buckets: bucket 0 is under 1 us, bucket i covers [2^(i-1), 2^i) us.
+
+enum PerfStage : uint8_t {
+    PERF_SERIAL,      // Serial command handling
+    PERF_BUTTON,      // Button polling and hold preview
+    PERF_WEB,         // WiFi reconnect and web server requests
+    PERF_SCHEDULER,   // Clock sync, refresh decisions and fetch slices
+    PERF_SNAPSHOT,    // Cache snapshot to flash
+    PERF_DISPLAY,     // Screen render and transfer
+    PERF_LOOP,        // Whole loop() body, excluding the trailing delay()
+    PERF_STAGE_COUNT
+};
+
+#define PERF_BUCKETS 24   // Last bucket also takes anything slower (4 s+)
+
+struct PerfStats {
+    uint32_t count;
+    uint32_t minCycles;
+    uint32_t maxCycles;
+    uint64_t totalCycles;
+    uint32_t buckets[PERF_BUCKETS];
+};
+
+void perfBeginLoop();
+void perfLap(PerfStage stage);
+void perfEndLoop();   // Records PERF_LOOP; call after the last lap
+void perfReset();
+
+const PerfStats& perfStats(PerfStage stage);
+const char* perfStageName(PerfStage stage);
+uint32_t perfCyclesToMicros(uint64_t cycles);
+// Upper edge of the bucket holding the given percentile, capped at the max
+uint32_t perfPercentileMicros(PerfStage stage, uint8_t percentile);
+
+#endif // PROFILER_H
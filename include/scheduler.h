@@ -2,7 +2,9 @@
 #define SCHEDULER_H
 
 #include <Arduino.h>
-#include <map>
+#include "http_fetch.h"
+#include "config.h"
+#include "module_registry.h"
 
 // Forward declaration
 class ModuleInterface;
@@ -15,38 +17,129 @@ enum SchedulerState {
     RETRY_WAIT    // Backing off after failure
 };
 
+// Background refresh queue entry (earliest deadline first)
+struct RefreshEntry {
+    uint64_t deadline;        // uptimeSeconds() when the module is due
+    ModuleId module;
+};
+
+// Request budget for one upstream host: a token bucket holding up to
+// burst requests, refilled with one token every refillSeconds
+struct HostLimit {
+    const char* host;         // nullptr = any other host
+    uint8_t burst;
+    uint16_t refillSeconds;
+};
+
+struct HostBucket {
+    const HostLimit* limit;
+    float tokens;
+    uint64_t lastRefill;         // uptimeSeconds()
+    uint64_t blockedUntil;       // Retry-After from a 429 (0 = not blocked)
+};
+
+// Retry state of one module (indexed by ModuleId)
+struct ModuleBackoff {
+    uint8_t retryCount;
+    uint64_t retryAt;            // uptimeSeconds() (0 = no backoff)
+};
+
+// Fetch outcomes of one module (indexed by ModuleId)
+struct ModuleFetchStats {
+    uint32_t fetches;            // Completed fetches, successful or not
+    uint32_t failures;
+    uint32_t timed;              // Fetches that went over the network
+    uint32_t totalMs;            // Request time of those, connect to last byte
+    uint32_t lastMs;
+};
+
 // Scheduler context
 struct SchedulerContext {
     SchedulerState state;
-    unsigned long lastFetchTime;
-    unsigned long nextAllowedFetch;
-    uint8_t retryCount;
-    uint16_t retryDelay;
-    String currentModule;
+    uint64_t lastFetchTime;      // uptimeSeconds() (TIME_NEVER = no fetch yet)
+    uint64_t nextAllowedFetch;
+    bool forced;
+    ModuleId currentModule;
 };
 
 class Scheduler {
 private:
-    std::map<String, ModuleInterface*> modules;
     SchedulerContext context;
-    unsigned long lastGlobalFetch;
+    uint64_t lastGlobalFetch;
+
+    // In-flight HTTP request, advanced by tick()
+    HttpFetch fetcher;
+
+    // Forced fetches that arrived while another fetch was in flight
+    static const uint8_t MAX_PENDING = MODULE_COUNT;
+    ModuleId pendingFetches[MAX_PENDING];
+    uint8_t pendingCount;
+
+    // Modules sharing the in-flight request (first is the one requested)
+    static const uint8_t MAX_BATCH = MODULE_COUNT;
+    ModuleId batchMembers[MAX_BATCH];
+    uint8_t batchCount;
+
+    // Response parsing: the union of the batch members' filters, and the
+    // filtered document the body task parses the response into as it
+    // arrives (see parseBody()); the body itself is never held in RAM
+    static const size_t RESPONSE_FILTER_SIZE = 256;
+    static const size_t RESPONSE_DOC_SIZE = 384;  // Kept keys and strings are copied in
+    StaticJsonDocument<RESPONSE_FILTER_SIZE> responseFilter;
+    StaticJsonDocument<RESPONSE_DOC_SIZE> responseDoc;
+    DeserializationError parseError;
 
     static const uint16_t GLOBAL_MIN_INTERVAL = 10;  // 10 seconds between any fetches
+    static const uint16_t DEFAULT_RETRY_AFTER = 60;  // 429 without a usable Retry-After
+
+    // Independent failure backoff per module and request budget per host
+    ModuleBackoff backoff[MODULE_COUNT];
+    static const uint8_t HOST_LIMIT_COUNT = 4;
+    HostBucket buckets[HOST_LIMIT_COUNT];
+
+    // Fetch counts and timings per module (exported on /metrics)
+    ModuleFetchStats moduleStats[MODULE_COUNT];
+    static const uint16_t STALE_MARGIN = 60;  // Refresh background modules this long before isCacheStale()
+
+    // Min-heap of background module deadlines. The active module is checked
+    // first on every tick; the heap is rebuilt after each fetch or when the
+    // active module or refresh interval changes.
+    RefreshEntry refreshQueue[MODULE_COUNT];
+    uint8_t refreshCount;
+    bool queueDirty;
+    ModuleId queuedActive;
+    uint16_t queuedInterval;
+    uint32_t backgroundCount;
 
     uint16_t calculateBackoff(uint8_t retryCount);
+    HostBucket& bucketFor(const String& host);
+    unsigned long bucketWait(HostBucket& bucket, uint64_t now, bool forced);
+    void deferFetch(ModuleId id, uint64_t retryAt);
     void executeFetch();
+    void pollFetch();
+    void completeFetch(bool success, const String& errorMsg);
+    void queuePending(ModuleId id);
+    void removePending(ModuleId id);
+    bool buildBatch(ModuleId id, String& url);
+    bool readResponse(String& errorMsg, bool* parsed);  // parsed: one flag per batch member
+    static void parseBody(Stream& body, void* arg);
+    bool isCoolingDown(uint64_t now);
+    void buildRefreshQueue(ModuleId activeModule, uint16_t refreshInterval);
 
 public:
     Scheduler();
-    ~Scheduler();
 
     void init();
-    void registerModule(ModuleInterface* module);
     void tick();
-    void requestFetch(const char* moduleId, bool forced = false);
+    void requestFetch(ModuleId id, bool forced = false);
 
     SchedulerState getState() { return context.state; }
-    String getCurrentModule() { return context.currentModule; }
+    const SchedulerContext& getContext() { return context; }
+    const ModuleBackoff& getBackoff(ModuleId id) { return backoff[id]; }
+    const ModuleFetchStats& getModuleStats(ModuleId id) { return moduleStats[id]; }
+    ModuleId getCurrentModule() { return context.currentModule; }
+    const FetchStats& getFetchStats() { return fetcher.getStats(); }
+    uint32_t getBackgroundCount() { return backgroundCount; }
 };
 
 #endif // SCHEDULER_H
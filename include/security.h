@@ -2,20 +2,21 @@
 #define SECURITY_H
 
 #include <Arduino.h>
+#include "clock.h"
 
 // Security code state
 struct SecurityCode {
     uint32_t code;               // 6-digit number (100000-999999)
-    unsigned long generatedAt;   // millis() when created
+    uint64_t generatedAt;        // uptimeMillis() when created (TIME_NEVER = no code)
     bool used;                   // true after successful auth
     uint8_t failedAttempts;      // count of failed attempts
-    unsigned long lockoutUntil;  // millis() when lockout ends
+    uint64_t lockoutUntil;       // uptimeMillis() when lockout ends (0 = not locked)
 };
 
 // Session token state
 struct Session {
     char token[33];              // 32-char hex string + null terminator
-    unsigned long expiresAt;     // millis() when expires (30 min)
+    uint64_t expiresAt;          // uptimeMillis() when expires (30 min)
     bool active;                 // true if session is valid
 };
 
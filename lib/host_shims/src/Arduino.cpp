@@ -0,0 +1,498 @@
+#include "Arduino.h"
+#include "esp_timer.h"
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <poll.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <unistd.h>
+
+// ============================================
+// Fake clock
+// ============================================
+
+static uint64_t clockMicros = 0;
+
+// Timers and scheduled pin changes fire as the clock passes their due time
+struct esp_timer {
+    esp_timer_cb_t callback;
+    void* arg;
+    uint64_t due;
+    uint64_t period;  // 0 = one-shot
+    bool active;
+};
+
+struct PinChange {
+    uint64_t due;
+    uint8_t pin;
+    uint16_t value;
+};
+
+// FreeRTOS task, resumed when the clock reaches wakeAt
+struct HostTask {
+    TaskFunction_t function;
+    void* arg;
+    uint64_t wakeAt;
+    bool finished;
+};
+
+static std::vector<esp_timer*> timers;
+static std::vector<PinChange> pinChanges;
+static std::vector<HostTask*> tasks;
+static bool advancing = false;
+
+static void applyPinChange(uint8_t pin, uint16_t value);
+static void resumeTask(HostTask* task);
+static void blockTask(uint64_t wakeAt);
+static thread_local HostTask* currentTask = nullptr;  // nullptr = loop() thread
+
+static void advanceClock(uint64_t target) {
+    // A task that waits for the clock blocks until the loop() thread gets
+    // there, like a FreeRTOS task in vTaskDelay()
+    if (currentTask) {
+        blockTask(target);
+        return;
+    }
+
+    // A callback that delays only moves the clock; the outer loop fires
+    // whatever became due meanwhile
+    if (advancing) {
+        if (target > clockMicros) clockMicros = target;
+        return;
+    }
+    advancing = true;
+
+    for (;;) {
+        uint64_t next = target;
+        for (esp_timer* t : timers) {
+            if (t->active && t->due < next) next = t->due;
+        }
+        for (const PinChange& c : pinChanges) {
+            if (c.due < next) next = c.due;
+        }
+        for (HostTask* task : tasks) {
+            if (task->wakeAt < next) next = task->wakeAt;
+        }
+        if (next > clockMicros) clockMicros = next;
+
+        for (size_t i = 0; i < pinChanges.size();) {
+            if (pinChanges[i].due <= clockMicros) {
+                applyPinChange(pinChanges[i].pin, pinChanges[i].value);
+                pinChanges.erase(pinChanges.begin() + i);
+            } else {
+                i++;
+            }
+        }
+        for (size_t i = 0; i < timers.size(); i++) {
+            esp_timer* t = timers[i];
+            if (!t->active || t->due > clockMicros) continue;
+            if (t->period) {
+                t->due += t->period;
+            } else {
+                t->active = false;
+            }
+            t->callback(t->arg);
+        }
+        for (size_t i = 0; i < tasks.size();) {
+            HostTask* task = tasks[i];
+            if (task->wakeAt <= clockMicros) resumeTask(task);
+            if (task->finished) {
+                tasks.erase(tasks.begin() + i);
+                delete task;
+            } else {
+                i++;
+            }
+        }
+
+        if (clockMicros >= target) break;
+    }
+
+    advancing = false;
+}
+
+uint32_t millis() {
+    return (uint32_t)(clockMicros / 1000);
+}
+
+uint32_t micros() {
+    return (uint32_t)clockMicros;
+}
+
+void delay(unsigned long ms) {
+    advanceClock(clockMicros + (uint64_t)ms * 1000);
+}
+
+void delayMicroseconds(unsigned int us) {
+    advanceClock(clockMicros + us);
+}
+
+void yield() {
+}
+
+void hostSetMillis(unsigned long ms) {
+    // Jumping the clock rebases running timers instead of replaying them
+    uint64_t target = (uint64_t)ms * 1000;
+    for (esp_timer* t : timers) {
+        if (t->active) t->due = target + (t->due > clockMicros ? t->due - clockMicros : 0);
+    }
+    for (HostTask* task : tasks) {
+        task->wakeAt = target + (task->wakeAt > clockMicros ? task->wakeAt - clockMicros : 0);
+    }
+    clockMicros = target;
+}
+
+void hostAdvanceMillis(unsigned long ms) {
+    advanceClock(clockMicros + (uint64_t)ms * 1000);
+}
+
+void hostAdvanceMicros(unsigned long us) {
+    advanceClock(clockMicros + us);
+}
+
+// ============================================
+// esp_timer
+// ============================================
+
+esp_err_t esp_timer_create(const esp_timer_create_args_t* args, esp_timer_handle_t* out) {
+    if (!args || !args->callback || !out) return ESP_ERR_INVALID_ARG;
+    esp_timer* t = new esp_timer{ args->callback, args->arg, 0, 0, false };
+    timers.push_back(t);
+    *out = t;
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_start_periodic(esp_timer_handle_t timer, uint64_t periodUs) {
+    if (!timer || periodUs == 0) return ESP_ERR_INVALID_ARG;
+    if (timer->active) return ESP_ERR_INVALID_STATE;
+    timer->period = periodUs;
+    timer->due = clockMicros + periodUs;
+    timer->active = true;
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_start_once(esp_timer_handle_t timer, uint64_t timeoutUs) {
+    if (!timer) return ESP_ERR_INVALID_ARG;
+    if (timer->active) return ESP_ERR_INVALID_STATE;
+    timer->period = 0;
+    timer->due = clockMicros + timeoutUs;
+    timer->active = true;
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_stop(esp_timer_handle_t timer) {
+    if (!timer) return ESP_ERR_INVALID_ARG;
+    if (!timer->active) return ESP_ERR_INVALID_STATE;
+    timer->active = false;
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_delete(esp_timer_handle_t timer) {
+    if (!timer) return ESP_ERR_INVALID_ARG;
+    timers.erase(std::remove(timers.begin(), timers.end(), timer), timers.end());
+    delete timer;
+    return ESP_OK;
+}
+
+int64_t esp_timer_get_time() {
+    return (int64_t)clockMicros;
+}
+
+// ============================================
+// GPIO
+// ============================================
+
+static std::map<uint8_t, uint16_t> pinValues;
+
+void pinMode(uint8_t pin, uint8_t mode) {
+    if (mode == INPUT_PULLUP && pinValues.find(pin) == pinValues.end()) {
+        pinValues[pin] = 4095;
+    }
+}
+
+int digitalRead(uint8_t pin) {
+    return analogRead(pin) > 2047 ? HIGH : LOW;
+}
+
+void digitalWrite(uint8_t pin, uint8_t value) {
+    pinValues[pin] = value ? 4095 : 0;
+}
+
+uint16_t analogRead(uint8_t pin) {
+    auto it = pinValues.find(pin);
+    return it == pinValues.end() ? 0 : it->second;
+}
+
+void hostSetPin(uint8_t pin, uint16_t analogValue) {
+    pinValues[pin] = analogValue;
+}
+
+static void applyPinChange(uint8_t pin, uint16_t value) {
+    pinValues[pin] = value;
+}
+
+void hostSchedulePin(uint8_t pin, unsigned long atMs, uint16_t analogValue) {
+    pinChanges.push_back({ (uint64_t)atMs * 1000, pin, analogValue });
+}
+
+// ============================================
+// Random
+// ============================================
+
+void randomSeed(unsigned long seed) {
+    srand((unsigned int)seed);
+}
+
+long random(long howBig) {
+    if (howBig <= 0) return 0;
+    return rand() % howBig;
+}
+
+long random(long howSmall, long howBig) {
+    if (howSmall >= howBig) return howSmall;
+    return howSmall + random(howBig - howSmall);
+}
+
+// ============================================
+// Print / Stream
+// ============================================
+
+size_t Print::write(const uint8_t* buffer, size_t size) {
+    size_t n = 0;
+    while (size--) {
+        n += write(*buffer++);
+    }
+    return n;
+}
+
+size_t Print::printf(const char* format, ...) {
+    char small[128];
+    va_list args;
+    va_start(args, format);
+    int len = vsnprintf(small, sizeof(small), format, args);
+    va_end(args);
+    if (len < 0) return 0;
+    if ((size_t)len < sizeof(small)) {
+        return write((const uint8_t*)small, len);
+    }
+
+    char* big = (char*)malloc(len + 1);
+    if (!big) return 0;
+    va_start(args, format);
+    vsnprintf(big, len + 1, format, args);
+    va_end(args);
+    size_t n = write((const uint8_t*)big, len);
+    free(big);
+    return n;
+}
+
+size_t Print::print(long n, int base) {
+    return print(String(n, (unsigned char)base));
+}
+
+size_t Print::print(unsigned long n, int base) {
+    return print(String(n, (unsigned char)base));
+}
+
+size_t Print::print(long long n, int base) {
+    return print(String(n, (unsigned char)base));
+}
+
+size_t Print::print(unsigned long long n, int base) {
+    return print(String(n, (unsigned char)base));
+}
+
+size_t Print::print(double n, int digits) {
+    return print(String(n, (unsigned int)digits));
+}
+
+size_t Stream::readBytes(char* buffer, size_t length) {
+    size_t count = 0;
+    while (count < length) {
+        int c = read();
+        if (c < 0) break;
+        buffer[count++] = (char)c;
+    }
+    return count;
+}
+
+String Stream::readString() {
+    String ret;
+    int c;
+    while ((c = read()) >= 0) {
+        ret += (char)c;
+    }
+    return ret;
+}
+
+String Stream::readStringUntil(char terminator) {
+    String ret;
+    int c;
+    while ((c = read()) >= 0 && c != terminator) {
+        ret += (char)c;
+    }
+    return ret;
+}
+
+// ============================================
+// Serial (stdin/stdout)
+// ============================================
+
+HardwareSerial Serial;
+static bool serialQuiet = false;
+static bool stdinClosed = false;
+
+void hostSetQuiet(bool quiet) {
+    serialQuiet = quiet;
+}
+
+// stdin is read raw into our own buffer: stdio buffering would swallow piped
+// input that poll() then no longer reports
+static char stdinBuffer[256];
+static size_t stdinHead = 0;
+static size_t stdinTail = 0;
+
+int HardwareSerial::available() {
+    if (stdinHead < stdinTail) return (int)(stdinTail - stdinHead);
+    if (stdinClosed) return 0;
+    struct pollfd pfd = { STDIN_FILENO, POLLIN, 0 };
+    if (poll(&pfd, 1, 0) <= 0 || !(pfd.revents & (POLLIN | POLLHUP))) return 0;
+    ssize_t n = ::read(STDIN_FILENO, stdinBuffer, sizeof(stdinBuffer));
+    if (n <= 0) {
+        stdinClosed = true;
+        return 0;
+    }
+    stdinHead = 0;
+    stdinTail = (size_t)n;
+    return (int)n;
+}
+
+int HardwareSerial::read() {
+    if (!available()) return -1;
+    return (uint8_t)stdinBuffer[stdinHead++];
+}
+
+int HardwareSerial::peek() {
+    if (!available()) return -1;
+    return (uint8_t)stdinBuffer[stdinHead];
+}
+
+size_t HardwareSerial::write(uint8_t c) {
+    if (!serialQuiet) fputc(c, stdout);
+    return 1;
+}
+
+size_t HardwareSerial::write(const uint8_t* buffer, size_t size) {
+    if (!serialQuiet) fwrite(buffer, 1, size, stdout);
+    return size;
+}
+
+void HardwareSerial::flush() {
+    fflush(stdout);
+}
+
+// ============================================
+// ESP
+// ============================================
+
+EspClass ESP;
+
+void EspClass::restart() {
+    fflush(stdout);
+    fprintf(stderr, "[host] ESP.restart() requested, exiting\n");
+    exit(0);
+}
+
+uint32_t EspClass::getFreeHeap() {
+    return 200 * 1024;
+}
+
+uint32_t EspClass::getHeapSize() {
+    return 320 * 1024;
+}
+
+uint32_t EspClass::getMinFreeHeap() {
+    return 180 * 1024;
+}
+
+uint32_t EspClass::getMaxAllocHeap() {
+    return 110 * 1024;
+}
+
+uint32_t EspClass::getCycleCount() {
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return (uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+}
+
+// ============================================
+// FreeRTOS tasks
+// ============================================
+
+// Hand-over between the loop() thread and task threads: whoever runs sets
+// runningTask and waits until it is handed back. Never destroyed, so task
+// threads still blocked at exit do not wait on a dead mutex.
+static std::mutex& taskMutex = *new std::mutex;
+static std::condition_variable& taskSwitch = *new std::condition_variable;
+static HostTask* runningTask = nullptr;
+
+static void resumeTask(HostTask* task) {
+    // loop() thread: run the task until it blocks or returns
+    std::unique_lock<std::mutex> lock(taskMutex);
+    runningTask = task;
+    taskSwitch.notify_all();
+    taskSwitch.wait(lock, [] { return runningTask == nullptr; });
+}
+
+static void blockTask(uint64_t wakeAt) {
+    HostTask* self = currentTask;
+    std::unique_lock<std::mutex> lock(taskMutex);
+    self->wakeAt = wakeAt;
+    runningTask = nullptr;
+    taskSwitch.notify_all();
+    taskSwitch.wait(lock, [self] { return runningTask == self; });
+}
+
+static void runTask(HostTask* task) {
+    currentTask = task;
+    {
+        std::unique_lock<std::mutex> lock(taskMutex);
+        taskSwitch.wait(lock, [task] { return runningTask == task; });
+    }
+    task->function(task->arg);
+
+    std::lock_guard<std::mutex> lock(taskMutex);
+    task->finished = true;
+    runningTask = nullptr;
+    taskSwitch.notify_all();
+}
+
+BaseType_t xTaskCreate(TaskFunction_t function, const char* name, uint32_t stackDepth,
+                       void* arg, UBaseType_t priority, TaskHandle_t* created) {
+    (void)name;
+    (void)stackDepth;
+    (void)priority;
+    HostTask* task = new HostTask{function, arg, clockMicros, false};
+    std::thread(runTask, task).detach();
+    if (created) *created = task;
+
+    // Runs straight away up to its first wait
+    resumeTask(task);
+    if (task->finished) {
+        delete task;
+    } else {
+        tasks.push_back(task);
+    }
+    return pdPASS;
+}
+
+void vTaskDelete(TaskHandle_t task) {
+    // The task function returns right after this and its thread ends
+    (void)task;
+}
+
+unsigned int uxTaskGetStackHighWaterMark(TaskHandle_t task) {
+    return 5 * 1024;
+}
@@ -0,0 +1,131 @@
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+// Host (Linux) replacement for the Arduino core header.
+// Only the subset of the API used by the firmware is provided; timing is
+// driven by a fake clock (see host_hal.h) so loops run at full host speed.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+
+#include "WString.h"
+#include "Stream.h"
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+#define HIGH 0x1
+#define LOW  0x0
+
+#define INPUT          0x01
+#define OUTPUT         0x03
+#define INPUT_PULLUP   0x05
+#define INPUT_PULLDOWN 0x09
+
+#define PROGMEM
+#define PGM_P const char*
+#define F(s) (s)
+#define IRAM_ATTR
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+using std::min;
+using std::max;
+
+// newlib (ESP32) has strlcpy; older glibc does not
+#if defined(__GLIBC__) && !(__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 38))
+inline size_t strlcpy(char* dst, const char* src, size_t size) {
+    size_t len = strlen(src);
+    if (size > 0) {
+        size_t n = len < size - 1 ? len : size - 1;
+        memcpy(dst, src, n);
+        dst[n] = '\0';
+    }
+    return len;
+}
+#endif
+
+// Timing (fake clock, advanced by delay()). 32 bits like the ESP32 core's
+// unsigned long: millis() wraps after ~49.7 days, micros() after ~71.6 minutes.
+uint32_t millis();
+uint32_t micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void yield();
+
+// GPIO (values are injected with hostSetPin())
+void pinMode(uint8_t pin, uint8_t mode);
+int digitalRead(uint8_t pin);
+void digitalWrite(uint8_t pin, uint8_t value);
+uint16_t analogRead(uint8_t pin);
+
+// SNTP (stand-in server, see esp_sntp.h)
+void configTime(long gmtOffsetSec, int daylightOffsetSec, const char* server1,
+                const char* server2 = nullptr, const char* server3 = nullptr);
+
+// Random numbers
+void randomSeed(unsigned long seed);
+long random(long howBig);
+long random(long howSmall, long howBig);
+
+// Serial console on stdin/stdout
+class HardwareSerial : public Stream {
+public:
+    void begin(unsigned long baud) { (void)baud; }
+    void end() {}
+    operator bool() const { return true; }
+
+    int available() override;
+    int read() override;
+    int peek() override;
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t* buffer, size_t size) override;
+    using Print::write;
+    void flush() override;
+};
+
+extern HardwareSerial Serial;
+
+// Chip-level helpers
+class EspClass {
+public:
+    void restart();
+    uint32_t getFreeHeap();
+    uint32_t getHeapSize();
+    uint32_t getMinFreeHeap();
+    uint32_t getMaxAllocHeap();
+    // Real host time, so loop profiles compare builds rather than the fake clock
+    uint32_t getCycleCount();
+    uint32_t getCpuFreqMHz() { return 1000; }   // One "cycle" per nanosecond
+    uint32_t getChipRevision() { return 0; }
+};
+
+extern EspClass ESP;
+
+// FreeRTOS tasks. Each host task gets a thread, but only one of them or
+// loop() runs at a time: a task runs from xTaskCreate() until it blocks in
+// delay() (or a shim call that costs fake time) and resumes once the fake
+// clock reaches its wake-up time, so runs stay deterministic.
+typedef void* TaskHandle_t;
+typedef void (*TaskFunction_t)(void* arg);
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+#define pdPASS 1
+#define pdFAIL 0
+#define tskIDLE_PRIORITY 0
+
+BaseType_t xTaskCreate(TaskFunction_t task, const char* name, uint32_t stackDepth,
+                       void* arg, UBaseType_t priority, TaskHandle_t* created);
+// Only vTaskDelete(nullptr) as a task's last statement is supported
+void vTaskDelete(TaskHandle_t task);
+
+// Task stack; the host reports a fixed figure
+unsigned int uxTaskGetStackHighWaterMark(TaskHandle_t task);
+
+#include "host_hal.h"
+
+#endif // HOST_ARDUINO_H
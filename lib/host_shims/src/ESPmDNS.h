@@ -0,0 +1,17 @@
+#ifndef HOST_ESPMDNS_H
+#define HOST_ESPMDNS_H
+
+#include "Arduino.h"
+
+class MDNSResponder {
+public:
+    bool begin(const char* hostName) { (void)hostName; return true; }
+    void end() {}
+    void addService(const char* service, const char* proto, uint16_t port) {
+        (void)service; (void)proto; (void)port;
+    }
+};
+
+extern MDNSResponder MDNS;
+
+#endif // HOST_ESPMDNS_H
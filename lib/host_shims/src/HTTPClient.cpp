@@ -0,0 +1,102 @@
+#include "HTTPClient.h"
+#include "host_net.h"
+#include <vector>
+
+static std::vector<HostCannedResponse> cannedResponses;
+static unsigned long requestCount = 0;
+static unsigned long bandwidthBytesPerMs = 0;
+static unsigned long connectCount = 0;
+static unsigned long handshakeLatencyMs = 0;
+static unsigned long retryAfterSeconds = 0;
+
+void hostAddHttpResponse(const char* urlPrefix, int status, const char* body, unsigned long latencyMs) {
+    cannedResponses.push_back({ String(urlPrefix), status, String(body), latencyMs });
+}
+
+void hostClearHttpResponses() {
+    cannedResponses.clear();
+}
+
+unsigned long hostHttpRequestCount() {
+    return requestCount;
+}
+
+void hostCountHttpRequest() {
+    requestCount++;
+}
+
+void hostSetHttpBandwidth(unsigned long bytesPerMs) {
+    bandwidthBytesPerMs = bytesPerMs;
+}
+
+unsigned long hostHttpBandwidth() {
+    return bandwidthBytesPerMs;
+}
+
+void hostCountConnect() {
+    connectCount++;
+}
+
+unsigned long hostConnectCount() {
+    return connectCount;
+}
+
+void hostSetHandshakeLatency(unsigned long ms) {
+    handshakeLatencyMs = ms;
+}
+
+unsigned long hostHandshakeLatency() {
+    return handshakeLatencyMs;
+}
+
+void hostSetRetryAfter(unsigned long seconds) {
+    retryAfterSeconds = seconds;
+}
+
+unsigned long hostRetryAfter() {
+    return retryAfterSeconds;
+}
+
+const HostCannedResponse* hostFindHttpResponse(const String& url) {
+    // Longest registered prefix wins
+    const HostCannedResponse* match = nullptr;
+    for (const auto& canned : cannedResponses) {
+        if (url.startsWith(canned.urlPrefix) &&
+            (!match || canned.urlPrefix.length() > match->urlPrefix.length())) {
+            match = &canned;
+        }
+    }
+    return match;
+}
+
+bool hostKnowsHttpHost(const String& host) {
+    for (const auto& canned : cannedResponses) {
+        int schemeEnd = canned.urlPrefix.indexOf("://");
+        if (schemeEnd < 0) continue;
+        String rest = canned.urlPrefix.substring(schemeEnd + 3);
+        int slash = rest.indexOf('/');
+        if ((slash >= 0 ? rest.substring(0, slash) : rest) == host) return true;
+    }
+    return false;
+}
+
+int HTTPClient::GET() {
+    hostCountHttpRequest();
+
+    const HostCannedResponse* match = hostFindHttpResponse(url);
+    if (!match) {
+        lastStatus = HTTPC_ERROR_CONNECTION_REFUSED;
+        return lastStatus;
+    }
+
+    if (match->latencyMs > timeout) {
+        hostAdvanceMillis(timeout);
+        lastStatus = HTTPC_ERROR_READ_TIMEOUT;
+        return lastStatus;
+    }
+
+    hostAdvanceMillis(match->latencyMs);
+    body = match->body;
+    lastStatus = match->status;
+    return lastStatus;
+}
@@ -0,0 +1,35 @@
+#ifndef HOST_HTTPCLIENT_H
+#define HOST_HTTPCLIENT_H
+
+#include "Arduino.h"
+#include "WiFiClient.h"
+
+#define HTTP_CODE_OK 200
+#define HTTP_CODE_TOO_MANY_REQUESTS 429
+#define HTTPC_ERROR_CONNECTION_REFUSED (-1)
+#define HTTPC_ERROR_READ_TIMEOUT (-11)
+
+// Host HTTP client: GET() is answered from the canned responses registered
+// with hostAddHttpResponse() and advances the fake clock by their latency.
+class HTTPClient {
+private:
+    String url;
+    String body;
+    int lastStatus = 0;
+    uint16_t timeout = 5000;
+
+public:
+    bool begin(WiFiClient& client, const String& requestUrl) { (void)client; return begin(requestUrl); }
+    bool begin(const String& requestUrl) { url = requestUrl; body = String(); lastStatus = 0; return true; }
+    void end() { url = String(); body = String(); }
+
+    void setTimeout(uint16_t ms) { timeout = ms; }
+    void setReuse(bool reuse) { (void)reuse; }
+    void addHeader(const String& name, const String& value) { (void)name; (void)value; }
+
+    int GET();
+    String getString() { return body; }
+    int getSize() { return (int)body.length(); }
+};
+
+#endif // HOST_HTTPCLIENT_H
@@ -0,0 +1,26 @@
+#include "host_hal.h"
+#include <new>
+#include <stdlib.h>
+
+// Count every operator new; Strings, JSON documents and containers all go through it
+static unsigned long heapAllocations = 0;
+
+unsigned long hostHeapAllocations() {
+    return heapAllocations;
+}
+
+void* operator new(size_t size) {
+    heapAllocations++;
+    void* p = malloc(size ? size : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* p) noexcept { free(p); }
+void operator delete[](void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+void operator delete[](void* p, size_t) noexcept { free(p); }
@@ -0,0 +1,168 @@
+#include "LittleFS.h"
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+LittleFSFS LittleFS;
+
+// ============================================
+// File
+// ============================================
+
+File::File(FILE* fp, const String& filePath)
+    : handle(fp, [](FILE* f) { fclose(f); }), path(filePath) {
+}
+
+size_t File::size() const {
+    if (!handle) return 0;
+    struct stat st;
+    fflush(handle.get());
+    if (fstat(fileno(handle.get()), &st) != 0) return 0;
+    return (size_t)st.st_size;
+}
+
+size_t File::position() const {
+    if (!handle) return 0;
+    long pos = ftell(handle.get());
+    return pos < 0 ? 0 : (size_t)pos;
+}
+
+bool File::seek(uint32_t pos) {
+    return handle && fseek(handle.get(), pos, SEEK_SET) == 0;
+}
+
+int File::available() {
+    if (!handle) return 0;
+    size_t total = size();
+    size_t pos = position();
+    return pos < total ? (int)(total - pos) : 0;
+}
+
+int File::read() {
+    if (!handle) return -1;
+    int c = fgetc(handle.get());
+    return c == EOF ? -1 : c;
+}
+
+int File::peek() {
+    if (!handle) return -1;
+    int c = fgetc(handle.get());
+    if (c == EOF) return -1;
+    ungetc(c, handle.get());
+    return c;
+}
+
+size_t File::readBytes(char* buffer, size_t length) {
+    if (!handle) return 0;
+    return fread(buffer, 1, length, handle.get());
+}
+
+size_t File::write(uint8_t c) {
+    if (!handle) return 0;
+    return fputc(c, handle.get()) == EOF ? 0 : 1;
+}
+
+size_t File::write(const uint8_t* buffer, size_t size) {
+    if (!handle) return 0;
+    return fwrite(buffer, 1, size, handle.get());
+}
+
+void File::flush() {
+    if (handle) fflush(handle.get());
+}
+
+// ============================================
+// LittleFS
+// ============================================
+
+LittleFSFS::LittleFSFS() {
+    const char* envRoot = getenv("DT_FS_ROOT");
+    root = envRoot ? envRoot : "littlefs_host";
+}
+
+void hostSetFsRoot(const char* path) {
+    LittleFS.setRoot(path);
+}
+
+String LittleFSFS::hostPath(const char* path) {
+    String full = root;
+    if (path[0] != '/') full += "/";
+    full += path;
+    return full;
+}
+
+bool LittleFSFS::begin(bool formatOnFail, const char* basePath, uint8_t maxOpenFiles,
+                       const char* partitionLabel) {
+    (void)basePath;
+    (void)maxOpenFiles;
+    (void)partitionLabel;
+
+    struct stat st;
+    if (stat(root.c_str(), &st) == 0 && S_ISDIR(st.st_mode)) {
+        mounted = true;
+        return true;
+    }
+    if (!formatOnFail) return false;
+
+    mounted = (::mkdir(root.c_str(), 0755) == 0);
+    return mounted;
+}
+
+bool LittleFSFS::format() {
+    DIR* dir = opendir(root.c_str());
+    if (dir) {
+        struct dirent* entry;
+        while ((entry = readdir(dir)) != nullptr) {
+            if (entry->d_type == DT_REG) {
+                String file = root + "/" + entry->d_name;
+                unlink(file.c_str());
+            }
+        }
+        closedir(dir);
+    }
+    return true;
+}
+
+File LittleFSFS::open(const char* path, const char* mode) {
+    if (!mounted) return File();
+
+    // LittleFS modes map directly onto stdio; add binary for symmetry
+    String stdioMode(mode);
+    if (stdioMode.indexOf('b') < 0) stdioMode += "b";
+
+    FILE* fp = fopen(hostPath(path).c_str(), stdioMode.c_str());
+    if (!fp) return File();
+    return File(fp, String(path));
+}
+
+bool LittleFSFS::exists(const char* path) {
+    struct stat st;
+    return mounted && stat(hostPath(path).c_str(), &st) == 0;
+}
+
+bool LittleFSFS::remove(const char* path) {
+    return mounted && unlink(hostPath(path).c_str()) == 0;
+}
+
+bool LittleFSFS::rename(const char* pathFrom, const char* pathTo) {
+    return mounted && ::rename(hostPath(pathFrom).c_str(), hostPath(pathTo).c_str()) == 0;
+}
+
+bool LittleFSFS::mkdir(const char* path) {
+    return mounted && ::mkdir(hostPath(path).c_str(), 0755) == 0;
+}
+
+size_t LittleFSFS::usedBytes() {
+    size_t used = 0;
+    DIR* dir = opendir(root.c_str());
+    if (!dir) return 0;
+    struct dirent* entry;
+    while ((entry = readdir(dir)) != nullptr) {
+        if (entry->d_type != DT_REG) continue;
+        struct stat st;
+        String file = root + "/" + entry->d_name;
+        if (stat(file.c_str(), &st) == 0) used += st.st_size;
+    }
+    closedir(dir);
+    return used;
+}
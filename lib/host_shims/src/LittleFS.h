@@ -0,0 +1,68 @@
+#ifndef HOST_LITTLEFS_H
+#define HOST_LITTLEFS_H
+
+#include "Arduino.h"
+#include <memory>
+#include <stdio.h>
+
+// Host file handle: a thin wrapper around stdio, shared on copy like fs::File
+class File : public Stream {
+private:
+    std::shared_ptr<FILE> handle;
+    String path;
+
+public:
+    File() {}
+    File(FILE* fp, const String& filePath);
+
+    operator bool() const { return (bool)handle; }
+    void close() { handle.reset(); }
+    const char* name() const { return path.c_str(); }
+    size_t size() const;
+    size_t position() const;
+    bool seek(uint32_t pos);
+
+    int available() override;
+    int read() override;
+    int peek() override;
+    size_t readBytes(char* buffer, size_t length) override;
+    size_t read(uint8_t* buffer, size_t length) { return readBytes((char*)buffer, length); }
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t* buffer, size_t size) override;
+    using Print::write;
+    void flush() override;
+};
+
+// Host LittleFS: paths map onto a directory on the build machine
+class LittleFSFS {
+private:
+    String root;
+    bool mounted = false;
+
+    String hostPath(const char* path);
+
+public:
+    LittleFSFS();
+
+    bool begin(bool formatOnFail = false, const char* basePath = "/littlefs",
+               uint8_t maxOpenFiles = 10, const char* partitionLabel = "spiffs");
+    void end() { mounted = false; }
+    bool format();
+
+    File open(const char* path, const char* mode = "r");
+    File open(const String& path, const char* mode = "r") { return open(path.c_str(), mode); }
+    bool exists(const char* path);
+    bool exists(const String& path) { return exists(path.c_str()); }
+    bool remove(const char* path);
+    bool rename(const char* pathFrom, const char* pathTo);
+    bool mkdir(const char* path);
+
+    size_t totalBytes() { return 1408 * 1024; }
+    size_t usedBytes();
+
+    void setRoot(const char* path) { root = path; }
+};
+
+extern LittleFSFS LittleFS;
+
+#endif // HOST_LITTLEFS_H
@@ -0,0 +1,5 @@
+#include "Wire.h"
+#include "ESPmDNS.h"
+
+TwoWire Wire;
+MDNSResponder MDNS;
@@ -0,0 +1,122 @@
+#include "U8g2lib.h"
+
+const u8g2_cb_t u8g2_cb_r0 = { 0 };
+
+// {advance width, ascent, descent}
+const uint8_t u8g2_font_helvB08_tr[] = { 6, 8, 2 };
+const uint8_t u8g2_font_helvB10_tr[] = { 8, 10, 3 };
+const uint8_t u8g2_font_6x10_tr[] = { 6, 8, 2 };
+const uint8_t u8g2_font_5x7_tr[] = { 5, 6, 1 };
+const uint8_t u8g2_font_logisoso24_tn[] = { 14, 24, 0 };
+
+U8G2::U8G2() {
+    clearBuffer();
+}
+
+void U8G2::clearBuffer() {
+    memset(buffer, 0, sizeof(buffer));
+}
+
+void U8G2::sendBuffer() {
+    framesSent++;
+    tilesSent += TILE_WIDTH * TILE_HEIGHT;
+}
+
+void U8G2::updateDisplayArea(uint8_t tx, uint8_t ty, uint8_t tw, uint8_t th) {
+    if (tx >= TILE_WIDTH || ty >= TILE_HEIGHT) return;
+    if (tx + tw > TILE_WIDTH) tw = TILE_WIDTH - tx;
+    if (ty + th > TILE_HEIGHT) th = TILE_HEIGHT - ty;
+    tilesSent += (uint32_t)tw * th;
+}
+
+void U8G2::drawPixel(u8g2_uint_t x, u8g2_uint_t y) {
+    if (x >= WIDTH || y >= HEIGHT) return;
+    uint8_t* byte = &buffer[(y / 8) * WIDTH + x];
+    uint8_t mask = (uint8_t)(1 << (y % 8));
+    if (drawColor == 1) *byte |= mask;
+    else if (drawColor == 0) *byte &= ~mask;
+    else *byte ^= mask;
+}
+
+void U8G2::drawHLine(u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w) {
+    for (u8g2_uint_t i = 0; i < w; i++) drawPixel(x + i, y);
+}
+
+void U8G2::drawVLine(u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t h) {
+    for (u8g2_uint_t i = 0; i < h; i++) drawPixel(x, y + i);
+}
+
+void U8G2::drawBox(u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h) {
+    for (u8g2_uint_t i = 0; i < h; i++) drawHLine(x, y + i, w);
+}
+
+void U8G2::drawFrame(u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h) {
+    if (w == 0 || h == 0) return;
+    drawHLine(x, y, w);
+    drawHLine(x, y + h - 1, w);
+    drawVLine(x, y, h);
+    drawVLine(x + w - 1, y, h);
+}
+
+void U8G2::drawCircle(u8g2_uint_t x0, u8g2_uint_t y0, u8g2_uint_t rad) {
+    // Midpoint circle
+    int x = rad, y = 0, err = 1 - x;
+    while (x >= y) {
+        drawPixel(x0 + x, y0 + y); drawPixel(x0 + y, y0 + x);
+        drawPixel(x0 - y, y0 + x); drawPixel(x0 - x, y0 + y);
+        drawPixel(x0 - x, y0 - y); drawPixel(x0 - y, y0 - x);
+        drawPixel(x0 + y, y0 - x); drawPixel(x0 + x, y0 - y);
+        y++;
+        if (err < 0) {
+            err += 2 * y + 1;
+        } else {
+            x--;
+            err += 2 * (y - x) + 1;
+        }
+    }
+}
+
+void U8G2::drawXBM(u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h, const uint8_t* bitmap) {
+    u8g2_uint_t stride = (w + 7) / 8;
+    for (u8g2_uint_t row = 0; row < h; row++) {
+        for (u8g2_uint_t col = 0; col < w; col++) {
+            if (bitmap[row * stride + col / 8] & (1 << (col % 8))) {
+                drawPixel(x + col, y + row);
+            }
+        }
+    }
+}
+
+void U8G2::drawGlyph(u8g2_uint_t x, u8g2_uint_t y, uint8_t c) {
+    if (c == ' ') return;
+    // Deterministic per-character pattern so distinct strings give distinct frames
+    uint8_t w = font[0] - 1;
+    uint8_t h = font[1];
+    for (uint8_t row = 0; row < h; row++) {
+        for (uint8_t col = 0; col < w; col++) {
+            if (((c * 31 + row * 7 + col * 13) % 5) < 2) {
+                drawPixel(x + col, y - h + 1 + row);
+            }
+        }
+    }
+}
+
+u8g2_uint_t U8G2::getStrWidth(const char* s) {
+    return s ? (u8g2_uint_t)(strlen(s) * font[0]) : 0;
+}
+
+u8g2_uint_t U8G2::drawStr(u8g2_uint_t x, u8g2_uint_t y, const char* s) {
+    if (!s) return 0;
+    u8g2_uint_t start = x;
+    for (; *s; s++) {
+        drawGlyph(x, y, (uint8_t)*s);
+        x += font[0];
+    }
+    return x - start;
+}
+
+size_t U8G2::write(uint8_t c) {
+    drawGlyph(cursorX, cursorY, c);
+    cursorX += font[0];
+    return 1;
+}
@@ -0,0 +1,97 @@
+#ifndef HOST_U8G2LIB_H
+#define HOST_U8G2LIB_H
+
+#include "Arduino.h"
+
+typedef uint16_t u8g2_uint_t;
+typedef struct { uint8_t rotation; } u8g2_cb_t;
+
+extern const u8g2_cb_t u8g2_cb_r0;
+#define U8G2_R0 (&u8g2_cb_r0)
+#define U8X8_PIN_NONE 255
+
+// Host fonts only carry metrics: {advance width, ascent, descent}
+extern const uint8_t u8g2_font_helvB08_tr[];
+extern const uint8_t u8g2_font_helvB10_tr[];
+extern const uint8_t u8g2_font_6x10_tr[];
+extern const uint8_t u8g2_font_5x7_tr[];
+extern const uint8_t u8g2_font_logisoso24_tn[];
+
+// Host U8g2: renders into a 128x64 page-ordered frame buffer (same layout
+// as the real full-buffer mode) and counts what would go over I2C.
+class U8G2 : public Print {
+public:
+    static const uint8_t WIDTH = 128;
+    static const uint8_t HEIGHT = 64;
+    static const uint8_t TILE_WIDTH = WIDTH / 8;
+    static const uint8_t TILE_HEIGHT = HEIGHT / 8;
+
+private:
+    uint8_t buffer[WIDTH * HEIGHT / 8];
+    const uint8_t* font = u8g2_font_6x10_tr;
+    uint8_t drawColor = 1;
+    u8g2_uint_t cursorX = 0;
+    u8g2_uint_t cursorY = 0;
+
+    // Bus accounting
+    uint32_t framesSent = 0;
+    uint32_t tilesSent = 0;
+
+    void drawGlyph(u8g2_uint_t x, u8g2_uint_t y, uint8_t c);
+
+public:
+    U8G2();
+
+    bool begin() { clearBuffer(); return true; }
+    void enableUTF8Print() {}
+    void setPowerSave(uint8_t on) { (void)on; }
+    void setContrast(uint8_t value) { (void)value; }
+
+    // Buffer management
+    void clearBuffer();
+    void sendBuffer();
+    void updateDisplayArea(uint8_t tx, uint8_t ty, uint8_t tw, uint8_t th);
+    uint8_t* getBufferPtr() { return buffer; }
+    uint8_t getBufferTileWidth() { return TILE_WIDTH; }
+    uint8_t getBufferTileHeight() { return TILE_HEIGHT; }
+    u8g2_uint_t getDisplayWidth() { return WIDTH; }
+    u8g2_uint_t getDisplayHeight() { return HEIGHT; }
+
+    // Text
+    void setFont(const uint8_t* f) { font = f; }
+    int8_t getAscent() { return (int8_t)font[1]; }
+    int8_t getDescent() { return -(int8_t)font[2]; }
+    u8g2_uint_t getStrWidth(const char* s);
+    u8g2_uint_t getUTF8Width(const char* s) { return getStrWidth(s); }
+    u8g2_uint_t drawStr(u8g2_uint_t x, u8g2_uint_t y, const char* s);
+    u8g2_uint_t drawUTF8(u8g2_uint_t x, u8g2_uint_t y, const char* s) { return drawStr(x, y, s); }
+    void setCursor(u8g2_uint_t x, u8g2_uint_t y) { cursorX = x; cursorY = y; }
+    size_t write(uint8_t c) override;
+    using Print::write;
+
+    // Graphics
+    void setDrawColor(uint8_t color) { drawColor = color; }
+    void drawPixel(u8g2_uint_t x, u8g2_uint_t y);
+    void drawHLine(u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w);
+    void drawVLine(u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t h);
+    void drawBox(u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h);
+    void drawFrame(u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h);
+    void drawCircle(u8g2_uint_t x0, u8g2_uint_t y0, u8g2_uint_t rad);
+    void drawXBM(u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h, const uint8_t* bitmap);
+
+    // Host-side inspection
+    uint32_t hostFramesSent() const { return framesSent; }
+    uint32_t hostTilesSent() const { return tilesSent; }
+    uint32_t hostBytesSent() const { return tilesSent * 8; }
+    void hostResetCounters() { framesSent = 0; tilesSent = 0; }
+};
+
+class U8G2_SH1106_128X64_NONAME_F_HW_I2C : public U8G2 {
+public:
+    U8G2_SH1106_128X64_NONAME_F_HW_I2C(const u8g2_cb_t* rotation, uint8_t reset = U8X8_PIN_NONE,
+                                       uint8_t clock = U8X8_PIN_NONE, uint8_t data = U8X8_PIN_NONE) {
+        (void)rotation; (void)reset; (void)clock; (void)data;
+    }
+};
+
+#endif // HOST_U8G2LIB_H
@@ -0,0 +1,148 @@
+#include "WString.h"
+#include <algorithm>
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+static std::string formatInteger(unsigned long long value, bool negative, unsigned char base) {
+    if (base < 2 || base > 36) base = 10;
+    char digits[72];
+    int pos = 0;
+    do {
+        int d = (int)(value % base);
+        digits[pos++] = (char)(d < 10 ? '0' + d : 'a' + d - 10);
+        value /= base;
+    } while (value > 0);
+    std::string out;
+    if (negative) out += '-';
+    while (pos > 0) out += digits[--pos];
+    return out;
+}
+
+static std::string formatSigned(long long value, unsigned char base) {
+    if (base == 10 && value < 0) {
+        return formatInteger(0ULL - (unsigned long long)value, true, base);
+    }
+    return formatInteger((unsigned long long)value, false, base);
+}
+
+static std::string formatFloat(double value, unsigned int decimalPlaces) {
+    char tmp[64];
+    snprintf(tmp, sizeof(tmp), "%.*f", (int)decimalPlaces, value);
+    return tmp;
+}
+
+String::String(unsigned char value, unsigned char base) : buf(formatInteger(value, false, base)) {}
+String::String(int value, unsigned char base) : buf(formatSigned(value, base)) {}
+String::String(unsigned int value, unsigned char base) : buf(formatInteger(value, false, base)) {}
+String::String(long value, unsigned char base) : buf(formatSigned(value, base)) {}
+String::String(unsigned long value, unsigned char base) : buf(formatInteger(value, false, base)) {}
+String::String(long long value, unsigned char base) : buf(formatSigned(value, base)) {}
+String::String(unsigned long long value, unsigned char base) : buf(formatInteger(value, false, base)) {}
+String::String(float value, unsigned int decimalPlaces) : buf(formatFloat(value, decimalPlaces)) {}
+String::String(double value, unsigned int decimalPlaces) : buf(formatFloat(value, decimalPlaces)) {}
+
+bool String::equalsIgnoreCase(const String& s) const {
+    if (buf.size() != s.buf.size()) return false;
+    for (size_t i = 0; i < buf.size(); i++) {
+        if (tolower((unsigned char)buf[i]) != tolower((unsigned char)s.buf[i])) return false;
+    }
+    return true;
+}
+
+bool String::endsWith(const String& suffix) const {
+    if (suffix.buf.size() > buf.size()) return false;
+    return buf.compare(buf.size() - suffix.buf.size(), suffix.buf.size(), suffix.buf) == 0;
+}
+
+int String::indexOf(char c, unsigned int fromIndex) const {
+    size_t pos = buf.find(c, fromIndex);
+    return pos == std::string::npos ? -1 : (int)pos;
+}
+
+int String::indexOf(const String& s, unsigned int fromIndex) const {
+    size_t pos = buf.find(s.buf, fromIndex);
+    return pos == std::string::npos ? -1 : (int)pos;
+}
+
+int String::lastIndexOf(char c) const {
+    size_t pos = buf.rfind(c);
+    return pos == std::string::npos ? -1 : (int)pos;
+}
+
+int String::lastIndexOf(const String& s) const {
+    size_t pos = buf.rfind(s.buf);
+    return pos == std::string::npos ? -1 : (int)pos;
+}
+
+String String::substring(unsigned int beginIndex) const {
+    if (beginIndex >= buf.size()) return String();
+    return String(buf.c_str() + beginIndex);
+}
+
+String String::substring(unsigned int beginIndex, unsigned int endIndex) const {
+    if (beginIndex > endIndex) std::swap(beginIndex, endIndex);
+    if (beginIndex >= buf.size()) return String();
+    if (endIndex > buf.size()) endIndex = (unsigned int)buf.size();
+    return String(buf.c_str() + beginIndex, endIndex - beginIndex);
+}
+
+void String::replace(char find, char replaceWith) {
+    std::replace(buf.begin(), buf.end(), find, replaceWith);
+}
+
+void String::replace(const String& find, const String& replaceWith) {
+    if (find.buf.empty()) return;
+    size_t pos = 0;
+    while ((pos = buf.find(find.buf, pos)) != std::string::npos) {
+        buf.replace(pos, find.buf.size(), replaceWith.buf);
+        pos += replaceWith.buf.size();
+    }
+}
+
+void String::remove(unsigned int index) {
+    if (index < buf.size()) buf.erase(index);
+}
+
+void String::remove(unsigned int index, unsigned int count) {
+    if (index < buf.size()) buf.erase(index, count);
+}
+
+void String::toLowerCase() {
+    for (auto& c : buf) c = (char)tolower((unsigned char)c);
+}
+
+void String::toUpperCase() {
+    for (auto& c : buf) c = (char)toupper((unsigned char)c);
+}
+
+void String::trim() {
+    size_t first = 0;
+    while (first < buf.size() && isspace((unsigned char)buf[first])) first++;
+    size_t last = buf.size();
+    while (last > first && isspace((unsigned char)buf[last - 1])) last--;
+    buf = buf.substr(first, last - first);
+}
+
+long String::toInt() const {
+    return strtol(buf.c_str(), nullptr, 10);
+}
+
+float String::toFloat() const {
+    return strtof(buf.c_str(), nullptr);
+}
+
+double String::toDouble() const {
+    return strtod(buf.c_str(), nullptr);
+}
+
+String operator+(const String& lhs, const String& rhs) { String r(lhs); r.concat(rhs); return r; }
+String operator+(const String& lhs, const char* rhs) { String r(lhs); r.concat(rhs); return r; }
+String operator+(const char* lhs, const String& rhs) { String r(lhs); r.concat(rhs); return r; }
+String operator+(const String& lhs, char rhs) { String r(lhs); r.concat(rhs); return r; }
+String operator+(const String& lhs, int rhs) { return lhs + String(rhs); }
+String operator+(const String& lhs, unsigned int rhs) { return lhs + String(rhs); }
+String operator+(const String& lhs, long rhs) { return lhs + String(rhs); }
+String operator+(const String& lhs, unsigned long rhs) { return lhs + String(rhs); }
+String operator+(const String& lhs, float rhs) { return lhs + String(rhs); }
+String operator+(const String& lhs, double rhs) { return lhs + String(rhs); }
@@ -0,0 +1,115 @@
+#ifndef HOST_WSTRING_H
+#define HOST_WSTRING_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+
+// Host stand-in for the Arduino String class (backed by std::string)
+class String {
+private:
+    std::string buf;
+
+public:
+    String() {}
+    String(const char* s) : buf(s ? s : "") {}
+    String(const char* s, size_t len) : buf(s ? std::string(s, len) : std::string()) {}
+    String(const String& other) = default;
+    String(String&& other) = default;
+    explicit String(char c) : buf(1, c) {}
+    explicit String(unsigned char value, unsigned char base = 10);
+    explicit String(int value, unsigned char base = 10);
+    explicit String(unsigned int value, unsigned char base = 10);
+    explicit String(long value, unsigned char base = 10);
+    explicit String(unsigned long value, unsigned char base = 10);
+    explicit String(long long value, unsigned char base = 10);
+    explicit String(unsigned long long value, unsigned char base = 10);
+    explicit String(float value, unsigned int decimalPlaces = 2);
+    explicit String(double value, unsigned int decimalPlaces = 2);
+
+    String& operator=(const String& rhs) = default;
+    String& operator=(String&& rhs) = default;
+    String& operator=(const char* s) { buf = s ? s : ""; return *this; }
+
+    // Capacity
+    bool reserve(unsigned int size) { buf.reserve(size); return true; }
+    unsigned int length() const { return (unsigned int)buf.length(); }
+    bool isEmpty() const { return buf.empty(); }
+
+    // Concatenation
+    bool concat(const String& s) { buf += s.buf; return true; }
+    bool concat(const char* s) { if (!s) return false; buf += s; return true; }
+    bool concat(const char* s, unsigned int len) { if (!s) return false; buf.append(s, len); return true; }
+    bool concat(char c) { buf += c; return true; }
+    bool concat(int v) { return concat(String(v)); }
+    bool concat(unsigned int v) { return concat(String(v)); }
+    bool concat(long v) { return concat(String(v)); }
+    bool concat(unsigned long v) { return concat(String(v)); }
+    bool concat(float v) { return concat(String(v)); }
+    bool concat(double v) { return concat(String(v)); }
+
+    template <typename T>
+    String& operator+=(const T& rhs) { concat(rhs); return *this; }
+
+    // Comparison
+    int compareTo(const String& s) const { return buf.compare(s.buf); }
+    bool equals(const String& s) const { return buf == s.buf; }
+    bool equals(const char* s) const { return buf == (s ? s : ""); }
+    bool equalsIgnoreCase(const String& s) const;
+    bool startsWith(const String& prefix) const { return buf.compare(0, prefix.buf.size(), prefix.buf) == 0; }
+    bool endsWith(const String& suffix) const;
+
+    bool operator==(const String& rhs) const { return equals(rhs); }
+    bool operator==(const char* rhs) const { return equals(rhs); }
+    bool operator!=(const String& rhs) const { return !equals(rhs); }
+    bool operator!=(const char* rhs) const { return !equals(rhs); }
+    bool operator<(const String& rhs) const { return buf < rhs.buf; }
+    bool operator>(const String& rhs) const { return buf > rhs.buf; }
+
+    // Character access
+    char charAt(unsigned int index) const { return index < buf.size() ? buf[index] : 0; }
+    void setCharAt(unsigned int index, char c) { if (index < buf.size()) buf[index] = c; }
+    char operator[](unsigned int index) const { return charAt(index); }
+    char& operator[](unsigned int index) { return buf[index]; }
+    const char* c_str() const { return buf.c_str(); }
+    const char* begin() const { return buf.c_str(); }
+    const char* end() const { return buf.c_str() + buf.size(); }
+
+    // Search
+    int indexOf(char c, unsigned int fromIndex = 0) const;
+    int indexOf(const String& s, unsigned int fromIndex = 0) const;
+    int lastIndexOf(char c) const;
+    int lastIndexOf(const String& s) const;
+    String substring(unsigned int beginIndex) const;
+    String substring(unsigned int beginIndex, unsigned int endIndex) const;
+
+    // Modification
+    void replace(char find, char replaceWith);
+    void replace(const String& find, const String& replaceWith);
+    void remove(unsigned int index);
+    void remove(unsigned int index, unsigned int count);
+    void toLowerCase();
+    void toUpperCase();
+    void trim();
+
+    // Parsing
+    long toInt() const;
+    float toFloat() const;
+    double toDouble() const;
+};
+
+String operator+(const String& lhs, const String& rhs);
+String operator+(const String& lhs, const char* rhs);
+String operator+(const char* lhs, const String& rhs);
+String operator+(const String& lhs, char rhs);
+String operator+(const String& lhs, int rhs);
+String operator+(const String& lhs, unsigned int rhs);
+String operator+(const String& lhs, long rhs);
+String operator+(const String& lhs, unsigned long rhs);
+String operator+(const String& lhs, float rhs);
+String operator+(const String& lhs, double rhs);
+
+inline bool operator==(const char* lhs, const String& rhs) { return rhs.equals(lhs); }
+inline bool operator!=(const char* lhs, const String& rhs) { return !rhs.equals(lhs); }
+
+#endif // HOST_WSTRING_H
@@ -0,0 +1,93 @@
+#include "WebServer.h"
+
+WebServer* WebServer::activeServer = nullptr;
+
+WebServer::WebServer(int port) {
+    (void)port;
+}
+
+WebServer::~WebServer() {
+    if (activeServer == this) activeServer = nullptr;
+}
+
+void WebServer::on(const String& uri, HTTPMethod method, THandlerFunction handler) {
+    routes.push_back({ uri, method, handler });
+}
+
+void WebServer::send(int code, const String& contentType, const String& content) {
+    response.code = code;
+    response.contentType = contentType;
+    response.body = content;
+    // Unknown length: the body follows in sendContent() chunks
+    streaming = (contentLength == CONTENT_LENGTH_UNKNOWN);
+    contentLength = 0;
+}
+
+void WebServer::sendContent(const char* content, size_t length) {
+    if (!streaming) {
+        fprintf(stderr, "[host] sendContent() without a streamed send()\n");
+        return;
+    }
+    if (length == 0) {
+        streaming = false;   // Terminating empty chunk
+        return;
+    }
+    response.body.concat(content, length);
+    response.chunks++;
+    if (length > response.largestChunk) response.largestChunk = length;
+}
+
+WebServer::HostResponse WebServer::hostRequest(HTTPMethod method, const char* uri, const char* body,
+                                               const char* authorization) {
+    response = HostResponse();
+    args.clear();
+    headers.clear();
+
+    // Split query string into args
+    String path(uri);
+    int query = path.indexOf('?');
+    if (query >= 0) {
+        String rest = path.substring(query + 1);
+        path = path.substring(0, query);
+        while (rest.length() > 0) {
+            int amp = rest.indexOf('&');
+            String pair = amp >= 0 ? rest.substring(0, amp) : rest;
+            rest = amp >= 0 ? rest.substring(amp + 1) : String();
+            int eq = pair.indexOf('=');
+            if (eq >= 0) {
+                args[pair.substring(0, eq)] = pair.substring(eq + 1);
+            } else if (pair.length() > 0) {
+                args[pair] = String();
+            }
+        }
+    }
+    if (body) args["plain"] = String(body);
+    if (authorization) headers["Authorization"] = String(authorization);
+
+    for (auto& route : routes) {
+        if (route.uri == path && (route.method == HTTP_ANY || route.method == method)) {
+            route.handler();
+            return response;
+        }
+    }
+
+    response.code = 404;
+    response.contentType = "text/plain";
+    response.body = "Not found";
+    return response;
+}
+
+void WebServer::hostQueueRequest(HTTPMethod method, const char* uri, const char* body,
+                                 const char* authorization) {
+    pending.push_back({ method, String(uri), String(body), String(authorization) });
+}
+
+void WebServer::handleClient() {
+    if (!running || pending.empty()) return;
+
+    PendingRequest request = pending.front();
+    pending.erase(pending.begin());
+    hostRequest(request.method, request.uri.c_str(),
+                request.body.length() > 0 ? request.body.c_str() : nullptr,
+                request.authorization.length() > 0 ? request.authorization.c_str() : nullptr);
+}
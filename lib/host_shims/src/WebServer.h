@@ -0,0 +1,93 @@
+#ifndef HOST_WEBSERVER_H
+#define HOST_WEBSERVER_H
+
+#include "Arduino.h"
+#include <functional>
+#include <map>
+#include <vector>
+
+typedef enum {
+    HTTP_ANY,
+    HTTP_GET,
+    HTTP_HEAD,
+    HTTP_POST,
+    HTTP_PUT,
+    HTTP_PATCH,
+    HTTP_DELETE,
+    HTTP_OPTIONS
+} HTTPMethod;
+
+#define CONTENT_LENGTH_UNKNOWN ((size_t)-1)
+
+// Host web server: no socket is opened. Requests are injected with
+// hostRequest() (or queued with hostQueueRequest() and served by
+// handleClient()) and the registered handlers run exactly as on the device.
+class WebServer {
+public:
+    typedef std::function<void(void)> THandlerFunction;
+
+    struct HostResponse {
+        int code = 0;
+        String contentType;
+        String body;
+        int chunks = 0;            // sendContent() calls after a streamed send()
+        size_t largestChunk = 0;
+    };
+
+private:
+    struct Route {
+        String uri;
+        HTTPMethod method;
+        THandlerFunction handler;
+    };
+
+    struct PendingRequest {
+        HTTPMethod method;
+        String uri;
+        String body;
+        String authorization;
+    };
+
+    std::vector<Route> routes;
+    std::vector<PendingRequest> pending;
+    std::map<String, String> args;
+    std::map<String, String> headers;
+    HostResponse response;
+    bool running = false;
+    size_t contentLength = 0;
+    bool streaming = false;
+
+    static WebServer* activeServer;
+
+public:
+    explicit WebServer(int port = 80);
+    ~WebServer();
+
+    void on(const String& uri, THandlerFunction handler) { on(uri, HTTP_ANY, handler); }
+    void on(const String& uri, HTTPMethod method, THandlerFunction handler);
+    void begin() { running = true; activeServer = this; }
+    void close() { running = false; }
+    void handleClient();
+
+    // Request accessors
+    bool hasArg(const String& name) { return args.find(name) != args.end(); }
+    String arg(const String& name) { return hasArg(name) ? args[name] : String(); }
+    String header(const String& name) { return headers.count(name) ? headers[name] : String(); }
+
+    // Responses
+    void send(int code, const String& contentType = String(), const String& content = String());
+    void send_P(int code, PGM_P contentType, PGM_P content) { send(code, String(contentType), String(content)); }
+    void sendHeader(const String& name, const String& value, bool first = false) { (void)name; (void)value; (void)first; }
+    void setContentLength(size_t length) { contentLength = length; }
+    void sendContent(const char* content, size_t length);
+    void sendContent(const String& content) { sendContent(content.c_str(), content.length()); }
+
+    // Host-side request injection
+    static WebServer* hostActive() { return activeServer; }
+    HostResponse hostRequest(HTTPMethod method, const char* uri, const char* body = nullptr,
+                             const char* authorization = nullptr);
+    void hostQueueRequest(HTTPMethod method, const char* uri, const char* body = nullptr,
+                          const char* authorization = nullptr);
+};
+
+#endif // HOST_WEBSERVER_H
@@ -0,0 +1,70 @@
+#include "WiFi.h"
+
+WiFiClass WiFi;
+
+static int apStations = 0;
+
+static const char* SCAN_SSIDS[] = { "HostNetwork", "HostNetwork-5G", "Neighbour" };
+static const int32_t SCAN_RSSI[] = { -48, -61, -83 };
+static const int SCAN_COUNT = 3;
+
+void hostSetApStations(int count) {
+    apStations = count;
+}
+
+wl_status_t WiFiClass::begin(const char* ssid, const char* passphrase) {
+    (void)passphrase;
+    stationSSID = ssid ? ssid : "";
+    currentStatus = stationSSID.length() > 0 ? WL_CONNECTED : WL_NO_SSID_AVAIL;
+    if (currentMode == WIFI_OFF) currentMode = WIFI_STA;
+    return currentStatus;
+}
+
+bool WiFiClass::disconnect(bool wifiOff) {
+    currentStatus = WL_DISCONNECTED;
+    if (wifiOff) currentMode = WIFI_OFF;
+    return true;
+}
+
+uint8_t* WiFiClass::macAddress(uint8_t* mac) {
+    static const uint8_t hostMac[6] = { 0x02, 0x00, 0x00, 0xA3, 0xF2, 0xE1 };
+    memcpy(mac, hostMac, sizeof(hostMac));
+    return mac;
+}
+
+bool WiFiClass::softAP(const char* ssid, const char* passphrase) {
+    (void)ssid;
+    (void)passphrase;
+    if (currentMode == WIFI_STA) currentMode = WIFI_AP_STA;
+    return true;
+}
+
+bool WiFiClass::softAPdisconnect(bool wifiOff) {
+    apStations = 0;
+    if (wifiOff) currentMode = WIFI_STA;
+    return true;
+}
+
+uint8_t WiFiClass::softAPgetStationNum() {
+    return (uint8_t)apStations;
+}
+
+int16_t WiFiClass::scanNetworks(bool async, bool showHidden, bool passive, uint32_t maxMsPerChan) {
+    (void)showHidden;
+    (void)passive;
+    (void)maxMsPerChan;
+    scanning = true;
+    return async ? WIFI_SCAN_RUNNING : SCAN_COUNT;
+}
+
+int16_t WiFiClass::scanComplete() {
+    return scanning ? SCAN_COUNT : WIFI_SCAN_FAILED;
+}
+
+String WiFiClass::SSID(uint8_t networkItem) {
+    return networkItem < SCAN_COUNT ? String(SCAN_SSIDS[networkItem]) : String();
+}
+
+int32_t WiFiClass::RSSI(uint8_t networkItem) {
+    return networkItem < SCAN_COUNT ? SCAN_RSSI[networkItem] : 0;
+}
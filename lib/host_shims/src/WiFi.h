@@ -0,0 +1,71 @@
+#ifndef HOST_WIFI_H
+#define HOST_WIFI_H
+
+#include "Arduino.h"
+#include "IPAddress.h"
+#include "WiFiClient.h"
+
+typedef enum {
+    WL_IDLE_STATUS = 0,
+    WL_NO_SSID_AVAIL = 1,
+    WL_CONNECTED = 3,
+    WL_CONNECT_FAILED = 4,
+    WL_DISCONNECTED = 6
+} wl_status_t;
+
+typedef enum {
+    WIFI_OFF = 0,
+    WIFI_STA = 1,
+    WIFI_AP = 2,
+    WIFI_AP_STA = 3
+} wifi_mode_t;
+
+typedef enum {
+    WIFI_POWER_19_5dBm = 78,
+    WIFI_POWER_8_5dBm = 34
+} wifi_power_t;
+
+#define WIFI_SCAN_RUNNING (-1)
+#define WIFI_SCAN_FAILED  (-2)
+
+// Host WiFi: station connects instantly, scans return a fixed network list
+class WiFiClass {
+private:
+    wifi_mode_t currentMode = WIFI_OFF;
+    wl_status_t currentStatus = WL_DISCONNECTED;
+    String stationSSID;
+    bool scanning = false;
+
+public:
+    bool mode(wifi_mode_t m) { currentMode = m; return true; }
+    wifi_mode_t getMode() { return currentMode; }
+
+    wl_status_t begin(const char* ssid, const char* passphrase = nullptr);
+    bool disconnect(bool wifiOff = false);
+    wl_status_t status() { return currentStatus; }
+    bool isConnected() { return currentStatus == WL_CONNECTED; }
+
+    IPAddress localIP() { return IPAddress(127, 0, 0, 1); }
+    String SSID() { return stationSSID; }
+    int8_t RSSI() { return isConnected() ? -55 : 0; }
+    uint8_t* macAddress(uint8_t* mac);
+    bool setTxPower(wifi_power_t power) { (void)power; return true; }
+
+    // Soft AP
+    bool softAP(const char* ssid, const char* passphrase = nullptr);
+    bool softAPdisconnect(bool wifiOff = false);
+    IPAddress softAPIP() { return IPAddress(192, 168, 4, 1); }
+    uint8_t softAPgetStationNum();
+
+    // Scanning
+    int16_t scanNetworks(bool async = false, bool showHidden = false, bool passive = false,
+                         uint32_t maxMsPerChan = 300);
+    int16_t scanComplete();
+    void scanDelete() { scanning = false; }
+    String SSID(uint8_t networkItem);
+    int32_t RSSI(uint8_t networkItem);
+};
+
+extern WiFiClass WiFi;
+
+#endif // HOST_WIFI_H
@@ -0,0 +1,118 @@
+#include "WiFiClient.h"
+#include "host_net.h"
+
+static const char* reasonPhrase(int status) {
+    switch (status) {
+        case 200: return "OK";
+        case 404: return "Not Found";
+        case 429: return "Too Many Requests";
+        case 500: return "Internal Server Error";
+        default: return "Status";
+    }
+}
+
+int WiFiClient::connect(const char* host, uint16_t port) {
+    stop();
+    if (!host || !hostKnowsHttpHost(String(host))) return 0;
+
+    // Every successful connect() is a full TCP + TLS handshake
+    hostCountConnect();
+    hostAdvanceMillis(hostHandshakeLatency());
+
+    remoteHost = host;
+    remotePort = port;
+    isOpen = true;
+    return 1;
+}
+
+void WiFiClient::stop() {
+    isOpen = false;
+    request = String();
+    response = String();
+    responsePos = 0;
+}
+
+uint8_t WiFiClient::connected() {
+    // Server closes after the response has been fully read
+    if (!isOpen) return 0;
+    if (response.length() > 0 && responsePos >= response.length()) return 0;
+    return 1;
+}
+
+void WiFiClient::serveRequest() {
+    int lineEnd = request.indexOf("\r\n");
+    String requestLine = request.substring(0, lineEnd);
+    int pathStart = requestLine.indexOf(' ');
+    int pathEnd = requestLine.indexOf(' ', pathStart + 1);
+    String path = requestLine.substring(pathStart + 1, pathEnd);
+    String url = String(remotePort == 443 ? "https://" : "http://") + remoteHost + path;
+
+    hostCountHttpRequest();
+    const HostCannedResponse* match = hostFindHttpResponse(url);
+    int status = match ? match->status : 404;
+    String body = match ? match->body : String("{}");
+
+    char retryAfter[32] = "";
+    if (status == 429 && hostRetryAfter() > 0) {
+        snprintf(retryAfter, sizeof(retryAfter), "Retry-After: %lu\r\n", hostRetryAfter());
+    }
+
+    char head[192];
+    snprintf(head, sizeof(head),
+             "HTTP/1.1 %d %s\r\nContent-Type: application/json\r\nContent-Length: %u\r\n%sConnection: close\r\n\r\n",
+             status, reasonPhrase(status), body.length(), retryAfter);
+    response = String(head) + body;
+    responsePos = 0;
+    responseReadyAt = millis() + (match ? match->latencyMs : 0);
+    request = String();
+}
+
+size_t WiFiClient::bytesReady() {
+    if (!isOpen || response.length() == 0) return 0;
+    uint32_t now = millis();
+    if ((int32_t)(now - responseReadyAt) < 0) return 0;
+
+    size_t deliverable = response.length();
+    unsigned long bandwidth = hostHttpBandwidth();
+    if (bandwidth > 0) {
+        size_t allowed = (size_t)(now - responseReadyAt + 1) * bandwidth;
+        if (allowed < deliverable) deliverable = allowed;
+    }
+    return deliverable > responsePos ? deliverable - responsePos : 0;
+}
+
+int WiFiClient::available() {
+    return (int)bytesReady();
+}
+
+int WiFiClient::read() {
+    if (bytesReady() == 0) return -1;
+    return (uint8_t)response[responsePos++];
+}
+
+int WiFiClient::read(uint8_t* buffer, size_t size) {
+    size_t ready = bytesReady();
+    if (ready == 0) return -1;
+    if (size > ready) size = ready;
+    memcpy(buffer, response.c_str() + responsePos, size);
+    responsePos += size;
+    return (int)size;
+}
+
+int WiFiClient::peek() {
+    if (bytesReady() == 0) return -1;
+    return (uint8_t)response[responsePos];
+}
+
+size_t WiFiClient::write(uint8_t c) {
+    return write(&c, 1);
+}
+
+size_t WiFiClient::write(const uint8_t* buffer, size_t size) {
+    if (!isOpen) return 0;
+    request.concat((const char*)buffer, (unsigned int)size);
+    if (request.indexOf("\r\n\r\n") >= 0) {
+        serveRequest();
+    }
+    return size;
+}
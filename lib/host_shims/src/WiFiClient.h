@@ -0,0 +1,42 @@
+#ifndef HOST_WIFICLIENT_H
+#define HOST_WIFICLIENT_H
+
+#include "Arduino.h"
+
+// Host TCP client. Connections succeed for hosts that have canned responses
+// (see hostAddHttpResponse()); an HTTP request written to the socket is
+// answered with the matching response once its latency has elapsed on the
+// fake clock, throttled by hostSetHttpBandwidth().
+class WiFiClient : public Stream {
+protected:
+    bool isOpen = false;
+    String remoteHost;
+    uint16_t remotePort = 0;
+
+    String request;
+    String response;
+    size_t responsePos = 0;
+    uint32_t responseReadyAt = 0;
+
+    void serveRequest();
+    size_t bytesReady();
+
+public:
+    virtual ~WiFiClient() {}
+
+    virtual int connect(const char* host, uint16_t port);
+    virtual int connect(const char* host, uint16_t port, int32_t timeoutMs) { (void)timeoutMs; return connect(host, port); }
+    virtual void stop();
+    virtual uint8_t connected();
+    operator bool() { return connected(); }
+
+    int available() override;
+    int read() override;
+    int read(uint8_t* buffer, size_t size);
+    int peek() override;
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t* buffer, size_t size) override;
+    using Print::write;
+};
+
+#endif // HOST_WIFICLIENT_H
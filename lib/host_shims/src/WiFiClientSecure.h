@@ -0,0 +1,13 @@
+#ifndef HOST_WIFICLIENTSECURE_H
+#define HOST_WIFICLIENTSECURE_H
+
+#include "WiFiClient.h"
+
+class WiFiClientSecure : public WiFiClient {
+public:
+    void setInsecure() {}
+    void setCACert(const char* rootCA) { (void)rootCA; }
+    void setHandshakeTimeout(unsigned long seconds) { (void)seconds; }
+};
+
+#endif // HOST_WIFICLIENTSECURE_H
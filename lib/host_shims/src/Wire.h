@@ -0,0 +1,18 @@
+#ifndef HOST_WIRE_H
+#define HOST_WIRE_H
+
+#include "Arduino.h"
+
+// I2C bus placeholder; the display shim keeps its frame buffer in memory
+class TwoWire {
+public:
+    bool begin(int sda = -1, int scl = -1, uint32_t frequency = 0) {
+        (void)sda; (void)scl; (void)frequency;
+        return true;
+    }
+    bool setClock(uint32_t frequency) { (void)frequency; return true; }
+};
+
+extern TwoWire Wire;
+
+#endif // HOST_WIRE_H
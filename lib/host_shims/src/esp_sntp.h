@@ -0,0 +1,15 @@
+#ifndef HOST_ESP_SNTP_H
+#define HOST_ESP_SNTP_H
+
+// Host SNTP: configTime() (declared in Arduino.h) talks to a stand-in
+// server set up with hostSetNtpServer(). Syncs are reported through the
+// notification callback on the fake clock, like the lwIP task does on the
+// device; nothing touches the host's real clock.
+
+#include <sys/time.h>
+
+typedef void (*sntp_sync_time_cb_t)(struct timeval* tv);
+
+void sntp_set_time_sync_notification_cb(sntp_sync_time_cb_t callback);
+
+#endif // HOST_ESP_SNTP_H
@@ -0,0 +1,54 @@
+#ifndef HOST_HAL_H
+#define HOST_HAL_H
+
+// Control surface for the native (host) build.
+// Lets benchmarks and experiments drive the fake clock, inject pin samples
+// and serve canned HTTP responses instead of talking to real hardware.
+
+#include <stdint.h>
+
+// Fake clock
+void hostSetMillis(unsigned long ms);
+void hostAdvanceMillis(unsigned long ms);
+void hostAdvanceMicros(unsigned long us);
+
+// GPIO injection (analog value; digital reads compare against mid-scale)
+void hostSetPin(uint8_t pin, uint16_t analogValue);
+// Same, applied when the fake clock reaches atMs (synthetic input streams)
+void hostSchedulePin(uint8_t pin, unsigned long atMs, uint16_t analogValue);
+
+// Silence Serial output (useful for benchmarks)
+void hostSetQuiet(bool quiet);
+
+// Canned HTTP responses, matched by longest URL prefix.
+// HTTPClient::GET() blocks for latencyMs (advances the fake clock);
+// WiFiClient holds the response back until latencyMs has elapsed.
+void hostAddHttpResponse(const char* urlPrefix, int status, const char* body, unsigned long latencyMs = 0);
+void hostClearHttpResponses();
+unsigned long hostHttpRequestCount();
+
+// Throttle WiFiClient reads of canned responses (bytes per fake ms, 0 = unlimited)
+void hostSetHttpBandwidth(unsigned long bytesPerMs);
+
+// WiFiClient connections: each connect() costs handshakeMs of fake clock,
+// blocking its caller (a task, or loop() itself)
+void hostSetHandshakeLatency(unsigned long handshakeMs);
+
+// Retry-After seconds sent with canned 429 responses (0 = header omitted)
+void hostSetRetryAfter(unsigned long seconds);
+unsigned long hostConnectCount();
+
+// Stand-in NTP server: Unix time at fake clock 0, answered latencyMs after
+// configTime() and hourly after that (epochAtBoot 0 = unreachable, the default)
+void hostSetNtpServer(unsigned long epochAtBoot, unsigned long latencyMs = 1000);
+
+// Directory that backs LittleFS (default: ./littlefs_host, or $DT_FS_ROOT)
+void hostSetFsRoot(const char* path);
+
+// Number of soft-AP stations reported by WiFi.softAPgetStationNum()
+void hostSetApStations(int count);
+
+// operator new calls since start (the host replaces the global allocator)
+unsigned long hostHeapAllocations();
+
+#endif // HOST_HAL_H
@@ -0,0 +1,255 @@
+// Entry point for the native (host) build.
+//
+// Usage: program [iterations]
+//   Runs setup() once, then loop() the given number of times (forever when
+//   omitted) and prints the mean wall-clock cost of loop() to stderr.
+//   Set DT_QUIET=1 to silence Serial output while benchmarking.
+//   Set DT_FS_ROOT=<dir> to choose the directory backing LittleFS.
+//   Set DT_HTTP_FIXTURES=<file> to load canned HTTP responses, one per line:
+//     <url prefix> <status> <latency ms> <body...>
+//   Set DT_HTTP_BANDWIDTH=<bytes per ms> to trickle socket responses.
+//   Set DT_TLS_HANDSHAKE_MS=<ms> for the cost of each new connection's
+//   handshake (default 800, about what an ESP32-C3 takes; 0 = free).
+//   Set DT_SCRAPE_MS=<ms> to scrape /metrics like Prometheus every <ms> of
+//   fake clock; each scrape is checked against the text format and the
+//   last one is written to DT_SCRAPE_OUT=<file> if set.
+//
+//   The report includes the worst fake-clock time spent inside a single
+//   loop() call, i.e. how long the device would stop responding, and how
+//   many loop() calls touched the heap at all. An idle loop should not: only
+//   iterations that fetch, serve a request or save should show up there.
+//   The program exits with status 1 when the worst loop() goes over
+//   DT_LOOP_BUDGET_MS (default 20).
+//
+// Not built into `pio test` binaries (PIO_UNIT_TESTING): each test under
+// test/ has its own main().
+
+#ifndef PIO_UNIT_TESTING
+
+#include "Arduino.h"
+#include "WebServer.h"
+#include "esp_timer.h"
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+
+void setup();
+void loop();
+
+#define DEFAULT_HANDSHAKE_MS 800
+#define DEFAULT_LOOP_BUDGET_MS 20
+
+static void loadHttpFixtures(const char* path) {
+    FILE* fp = fopen(path, "r");
+    if (!fp) {
+        fprintf(stderr, "[host] cannot open HTTP fixtures: %s\n", path);
+        return;
+    }
+
+    char line[4096];
+    int loaded = 0;
+    while (fgets(line, sizeof(line), fp)) {
+        char prefix[1024];
+        int status = 0;
+        unsigned long latency = 0;
+        int consumed = 0;
+        if (line[0] == '#' || sscanf(line, "%1023s %d %lu %n", prefix, &status, &latency, &consumed) < 3) {
+            continue;
+        }
+        char* body = line + consumed;
+        body[strcspn(body, "\r\n")] = '\0';
+        hostAddHttpResponse(prefix, status, body, latency);
+        loaded++;
+    }
+    fclose(fp);
+    fprintf(stderr, "[host] loaded %d HTTP fixtures from %s\n", loaded, path);
+}
+
+// ============================================
+// Prometheus scraper stand-in
+// ============================================
+
+struct ScrapeStats {
+    unsigned long scrapes;
+    unsigned long badLines;
+    unsigned long samples;     // Last scrape from here on
+    int chunks;
+    size_t largestChunk;
+    size_t bytes;
+};
+
+static bool isMetricNameChar(char c, bool first) {
+    return isalpha((unsigned char)c) || c == '_' || c == ':' || (!first && isdigit((unsigned char)c));
+}
+
+// One line of the text exposition format: "# HELP/TYPE ..." or name{labels} value
+static bool checkMetricLine(const char* line) {
+    if (line[0] == '#') {
+        return strncmp(line, "# HELP ", 7) == 0 || strncmp(line, "# TYPE ", 7) == 0;
+    }
+    const char* p = line;
+    if (!isMetricNameChar(*p, true)) return false;
+    while (isMetricNameChar(*p, false)) p++;
+    if (*p == '{') {
+        p++;
+        while (*p != '}') {
+            if (!isMetricNameChar(*p, true)) return false;
+            while (isMetricNameChar(*p, false)) p++;
+            if (p[0] != '=' || p[1] != '"') return false;
+            p += 2;
+            while (*p && *p != '"') p += (*p == '\\' && p[1]) ? 2 : 1;
+            if (*p != '"') return false;
+            p++;
+            if (*p == ',') p++;
+        }
+        p++;
+    }
+    if (*p != ' ') return false;
+    char* end;
+    strtod(p + 1, &end);
+    return end != p + 1 && (*end == '\0' || *end == ' ');
+}
+
+static void scrapeMetrics(ScrapeStats& stats, const char* outPath) {
+    WebServer* server = WebServer::hostActive();
+    if (!server) return;   // Settings server not up (AP mode or no WiFi yet)
+
+    WebServer::HostResponse response = server->hostRequest(HTTP_GET, "/metrics");
+    stats.scrapes++;
+    if (response.code != 200) {
+        fprintf(stderr, "[host] /metrics returned %d\n", response.code);
+        stats.badLines++;
+        return;
+    }
+
+    const char* body = response.body.c_str();
+    stats.samples = 0;
+    for (const char* line = body; *line;) {
+        const char* eol = strchr(line, '\n');
+        if (!eol) {
+            fprintf(stderr, "[host] /metrics: last line not newline-terminated\n");
+            stats.badLines++;
+            break;
+        }
+        std::string text(line, eol - line);
+        if (!checkMetricLine(text.c_str())) {
+            fprintf(stderr, "[host] /metrics: bad line: %s\n", text.c_str());
+            stats.badLines++;
+        } else if (text[0] != '#') {
+            stats.samples++;
+        }
+        line = eol + 1;
+    }
+    stats.chunks = response.chunks;
+    stats.largestChunk = response.largestChunk;
+    stats.bytes = response.body.length();
+
+    if (outPath) {
+        FILE* fp = fopen(outPath, "w");
+        if (fp) {
+            fwrite(body, 1, response.body.length(), fp);
+            fclose(fp);
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    unsigned long iterations = argc > 1 ? strtoul(argv[1], nullptr, 10) : 0;
+
+    // Start the fake clock late, e.g. just before the 32-bit millis() wrap
+    const char* startMs = getenv("DT_START_MS");
+    if (startMs) {
+        hostSetMillis(strtoul(startMs, nullptr, 10));
+    }
+
+    const char* fixtures = getenv("DT_HTTP_FIXTURES");
+    if (fixtures) {
+        loadHttpFixtures(fixtures);
+    }
+    const char* bandwidth = getenv("DT_HTTP_BANDWIDTH");
+    if (bandwidth) {
+        hostSetHttpBandwidth(strtoul(bandwidth, nullptr, 10));
+    }
+    const char* handshake = getenv("DT_TLS_HANDSHAKE_MS");
+    hostSetHandshakeLatency(handshake ? strtoul(handshake, nullptr, 10) : DEFAULT_HANDSHAKE_MS);
+    const char* ntpEpoch = getenv("DT_NTP_EPOCH");
+    if (ntpEpoch) {
+        hostSetNtpServer(strtoul(ntpEpoch, nullptr, 10));
+    }
+    const char* retryAfter = getenv("DT_RETRY_AFTER");
+    if (retryAfter) {
+        hostSetRetryAfter(strtoul(retryAfter, nullptr, 10));
+    }
+
+#ifdef BUTTON_PIN
+    // "start:duration,..." in fake-clock ms, e.g. DT_BUTTON_PRESSES=5000:200,9000:4000
+    const char* presses = getenv("DT_BUTTON_PRESSES");
+    for (const char* p = presses; p && *p;) {
+        char* end;
+        unsigned long at = strtoul(p, &end, 10);
+        if (end == p || *end != ':') break;
+        unsigned long length = strtoul(end + 1, &end, 10);
+        hostSchedulePin(BUTTON_PIN, at, 4095);
+        hostSchedulePin(BUTTON_PIN, at + length, 0);
+        p = (*end == ',') ? end + 1 : "";
+    }
+#endif
+
+    setup();
+
+    const char* quiet = getenv("DT_QUIET");
+    if (quiet && quiet[0] == '1') {
+        hostSetQuiet(true);
+    }
+
+    const char* loopBudget = getenv("DT_LOOP_BUDGET_MS");
+    unsigned long loopBudgetMs = loopBudget ? strtoul(loopBudget, nullptr, 10) : DEFAULT_LOOP_BUDGET_MS;
+
+    const char* scrapeMs = getenv("DT_SCRAPE_MS");
+    unsigned long scrapeInterval = scrapeMs ? strtoul(scrapeMs, nullptr, 10) : 0;
+    uint32_t nextScrape = millis() + scrapeInterval;
+    ScrapeStats scrape = {};
+
+    unsigned long worstLoopMs = 0;
+    unsigned long allocatingLoops = 0;
+    unsigned long loopAllocations = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned long i = 0; iterations == 0 || i < iterations; i++) {
+        uint32_t before = millis();
+        unsigned long allocationsBefore = hostHeapAllocations();
+        loop();
+        uint32_t spent = millis() - before;
+        if (spent > worstLoopMs) worstLoopMs = spent;
+        if (hostHeapAllocations() != allocationsBefore) {
+            allocatingLoops++;
+            loopAllocations += hostHeapAllocations() - allocationsBefore;
+        }
+        if (scrapeInterval > 0 && (int32_t)(millis() - nextScrape) >= 0) {
+            scrapeMetrics(scrape, getenv("DT_SCRAPE_OUT"));
+            nextScrape = millis() + scrapeInterval;
+        }
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    double totalUs = std::chrono::duration<double, std::micro>(elapsed).count();
+    fprintf(stderr, "[host] %lu loop() iterations, %.1f us total, %.3f us/iteration, fake clock %llu ms\n",
+            iterations, totalUs, iterations ? totalUs / iterations : 0.0,
+            (unsigned long long)(esp_timer_get_time() / 1000));
+    fprintf(stderr, "[host] worst loop() latency %lu ms (fake clock, includes delay()), budget %lu ms\n",
+            worstLoopMs, loopBudgetMs);
+    fprintf(stderr, "[host] %lu heap allocations in %lu of %lu loop() iterations\n",
+            loopAllocations, allocatingLoops, iterations);
+    if (scrapeInterval > 0) {
+        fprintf(stderr, "[host] %lu /metrics scrapes, %lu malformed lines; last: %lu samples, %zu bytes in %d chunks (largest %zu)\n",
+                scrape.scrapes, scrape.badLines, scrape.samples,
+                scrape.bytes, scrape.chunks, scrape.largestChunk);
+    }
+    fprintf(stderr, "[host] %lu HTTP requests over %lu connections\n", hostHttpRequestCount(), hostConnectCount());
+    if (worstLoopMs > loopBudgetMs) {
+        fprintf(stderr, "[host] FAIL: a loop() took %lu ms, over the %lu ms budget\n", worstLoopMs, loopBudgetMs);
+        return 1;
+    }
+    return 0;
+}
+
+#endif // PIO_UNIT_TESTING
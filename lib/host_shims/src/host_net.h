@@ -0,0 +1,24 @@
+#ifndef HOST_NET_H
+#define HOST_NET_H
+
+// Internal to the shims: canned response registry shared by HTTPClient and
+// WiFiClient.
+
+#include "Arduino.h"
+
+struct HostCannedResponse {
+    String urlPrefix;
+    int status;
+    String body;
+    unsigned long latencyMs;
+};
+
+const HostCannedResponse* hostFindHttpResponse(const String& url);
+bool hostKnowsHttpHost(const String& host);
+unsigned long hostHttpBandwidth();
+void hostCountHttpRequest();
+void hostCountConnect();
+unsigned long hostHandshakeLatency();
+unsigned long hostRetryAfter();
+
+#endif // HOST_NET_H
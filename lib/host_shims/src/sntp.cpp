@@ -0,0 +1,51 @@
+#include "Arduino.h"
+#include "esp_sntp.h"
+#include "esp_timer.h"
+#include <stdio.h>
+
+// Stand-in NTP server: Unix time at fake-clock 0 and the reply latency.
+// epochAtBoot == 0 means no server answers.
+static unsigned long ntpEpochAtBoot = 0;
+static unsigned long ntpLatencyMs = 1000;
+static const uint64_t NTP_RESYNC_US = 3600ULL * 1000000;  // lwIP default interval
+
+static sntp_sync_time_cb_t syncCallback = nullptr;
+static esp_timer_handle_t syncTimer = nullptr;
+
+void hostSetNtpServer(unsigned long epochAtBoot, unsigned long latencyMs) {
+    ntpEpochAtBoot = epochAtBoot;
+    ntpLatencyMs = latencyMs;
+}
+
+static void answerSync(void*) {
+    struct timeval tv;
+    // From the full 64-bit fake clock: the server's time does not wrap with millis()
+    uint64_t now = (uint64_t)esp_timer_get_time();
+    tv.tv_sec = (time_t)(ntpEpochAtBoot + now / 1000000);
+    tv.tv_usec = (suseconds_t)(now % 1000000);
+    if (syncCallback) {
+        syncCallback(&tv);
+    }
+    esp_timer_start_once(syncTimer, NTP_RESYNC_US);
+}
+
+void sntp_set_time_sync_notification_cb(sntp_sync_time_cb_t callback) {
+    syncCallback = callback;
+}
+
+void configTime(long gmtOffsetSec, int daylightOffsetSec, const char* server1, const char* server2, const char* server3) {
+    (void)gmtOffsetSec;
+    (void)daylightOffsetSec;
+    (void)server2;
+    (void)server3;
+    if (!syncTimer) {
+        esp_timer_create_args_t args = { answerSync, nullptr, ESP_TIMER_TASK, "sntp", false };
+        esp_timer_create(&args, &syncTimer);
+    }
+    esp_timer_stop(syncTimer);
+    if (ntpEpochAtBoot == 0 || !server1) {
+        fprintf(stderr, "[host] SNTP: no server configured\n");
+        return;
+    }
+    esp_timer_start_once(syncTimer, (uint64_t)ntpLatencyMs * 1000);
+}
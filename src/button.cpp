@@ -1,8 +1,8 @@
 #include "button.h"
 
 ButtonHandler::ButtonHandler(uint8_t buttonPin, bool capacitiveTouch)
-    : pin(buttonPin), lastState(false), pressStartTime(0),
-      lastDebounceTime(0), isPressed(false), touchBaseline(0),
+    : pin(buttonPin), gesture(), isHolding(false), holdStartTime(0), queueHead(0), queueTail(0),
+      droppedEvents(0), sampleTimer(nullptr), touchBaseline(0),
       touchThreshold(0), useCapacitiveTouch(capacitiveTouch) {
 }
 
@@ -23,10 +23,29 @@ void ButtonHandler::init() {
     } else {
         // Regular button with pull-up (LOW when pressed)
         pinMode(pin, INPUT_PULLUP);
-        lastState = digitalRead(pin) == LOW;
+        gesture.lastSample = digitalRead(pin) == LOW;
         Serial.print("Regular button initialized on GPIO");
         Serial.println(pin);
     }
+
+    // Sample from the esp_timer task; analogRead() is not ISR-safe, so the
+    // callback runs in task context rather than as a hardware interrupt
+    esp_timer_create_args_t timerArgs = {};
+    timerArgs.callback = &ButtonHandler::onSampleTimer;
+    timerArgs.arg = this;
+    timerArgs.dispatch_method = ESP_TIMER_TASK;
+    timerArgs.name = "button";
+
+    if (esp_timer_create(&timerArgs, &sampleTimer) != ESP_OK ||
+        esp_timer_start_periodic(sampleTimer, BUTTON_SAMPLE_INTERVAL_US) != ESP_OK) {
+        Serial.println("WARNING: Button timer unavailable, sampling from loop()");
+        sampleTimer = nullptr;
+    }
+}
+
+void ButtonHandler::onSampleTimer(void* arg) {
+    ButtonHandler* self = static_cast<ButtonHandler*>(arg);
+    self->sample(self->isTouched(), millis());
 }
 
 void ButtonHandler::calibrateTouch() {
@@ -65,54 +84,158 @@ bool ButtonHandler::isTouched() {
     return analogValue > 2000;
 }
 
-ButtonEvent ButtonHandler::check() {
-    bool currentState = isTouched();
-    unsigned long now = millis();
+ButtonEvent recognizeGesture(GestureState& state, bool touched, uint32_t now, uint32_t& duration) {
+    duration = 0;
 
-    // Debounce
-    if (currentState != lastState) {
-        lastDebounceTime = now;
+    // Debounce: a level counts once it has been stable for DEBOUNCE_DELAY
+    if (touched != state.lastSample) {
+        state.lastSample = touched;
+        state.lastChange = now;
     }
+    bool edge = false;
+    if (touched != state.pressed && (now - state.lastChange) > DEBOUNCE_DELAY) {
+        state.pressed = touched;
+        edge = true;
+    }
+    uint32_t held = now - state.pressStart;
 
-    if ((now - lastDebounceTime) > DEBOUNCE_DELAY) {
-        // Button pressed
-        if (currentState && !isPressed) {
-            isPressed = true;
-            pressStartTime = now;
-            Serial.println("Button touched");
-        }
-
-        // Button released
-        if (!currentState && isPressed) {
-            isPressed = false;
-            unsigned long pressDuration = now - pressStartTime;
-
-            Serial.print("Button released after ");
-            Serial.print(pressDuration);
-            Serial.println(" ms");
-
-            if (pressDuration >= FACTORY_RESET_MIN) {
-                Serial.println("Factory reset triggered");
-                return FACTORY_RESET;
-            } else if (pressDuration >= LONG_PRESS_MIN) {
-                Serial.println("Long press triggered (config mode)");
-                return LONG_PRESS;
-            } else if (pressDuration >= DEBOUNCE_DELAY && pressDuration < SHORT_PRESS_MAX) {
-                Serial.println("Short press triggered (cycle module)");
+    switch (state.phase) {
+        case GESTURE_IDLE:
+            if (edge && state.pressed) {
+                state.phase = GESTURE_FIRST_DOWN;
+                state.pressStart = now;
+            }
+            break;
+
+        case GESTURE_FIRST_DOWN:
+            if (!(edge && !state.pressed)) break;
+            duration = held;
+            state.phase = GESTURE_IDLE;
+            if (held >= FACTORY_RESET_MIN) return FACTORY_RESET;
+            if (held >= LONG_PRESS_MIN) return LONG_PRESS;
+            if (held >= DEBOUNCE_DELAY && held < SHORT_PRESS_MAX) {
+                // Could be the first half of a double tap
+                state.phase = GESTURE_WAIT_SECOND;
+                state.releaseTime = now;
+            }
+            break;  // Released between SHORT_PRESS_MAX and LONG_PRESS_MIN: cancelled
+
+        case GESTURE_WAIT_SECOND:
+            if (edge && state.pressed) {
+                state.phase = GESTURE_SECOND_DOWN;
+                state.pressStart = now;
+            } else if (now - state.releaseTime > DOUBLE_TAP_WINDOW) {
+                state.phase = GESTURE_IDLE;
+                duration = state.releaseTime - state.pressStart;
                 return SHORT_PRESS;
             }
-        }
-    }
+            break;
 
-    lastState = currentState;
+        case GESTURE_SECOND_DOWN:
+            if (edge && !state.pressed) {
+                state.phase = GESTURE_IDLE;
+                duration = held;
+                return DOUBLE_TAP;
+            }
+            if (held >= HOLD_REPEAT_DELAY) {
+                state.phase = GESTURE_REPEATING;
+                state.nextRepeat = now + HOLD_REPEAT_INTERVAL;
+                duration = held;
+                return REPEAT_PRESS;
+            }
+            break;
+
+        case GESTURE_REPEATING:
+            if (edge && !state.pressed) {
+                state.phase = GESTURE_IDLE;
+            } else if ((int32_t)(now - state.nextRepeat) >= 0) {
+                state.nextRepeat += HOLD_REPEAT_INTERVAL;
+                duration = held;
+                return REPEAT_PRESS;
+            }
+            break;
+    }
     return NONE;
 }
 
+void ButtonHandler::sample(bool touched, uint32_t now) {
+    uint32_t duration;
+    ButtonEvent event = recognizeGesture(gesture, touched, now, duration);
+
+    holdStartTime = gesture.pressStart;
+    isHolding = (gesture.phase == GESTURE_FIRST_DOWN);
+
+    if (event != NONE) {
+        pushEvent(event, now, duration);
+    }
+}
+
+void ButtonHandler::pushEvent(ButtonEvent type, uint32_t now, uint32_t duration) {
+    uint8_t head = queueHead.load(std::memory_order_relaxed);
+    uint8_t next = (head + 1) & (BUTTON_QUEUE_SIZE - 1);
+    if (next == queueTail.load(std::memory_order_acquire)) {
+        droppedEvents++;  // loop() has not drained for a while; keep the oldest
+        return;
+    }
+
+    queue[head] = { type, now, duration };
+    queueHead.store(next, std::memory_order_release);
+}
+
+bool ButtonHandler::nextEvent(ButtonEventRecord& event) {
+    uint8_t tail = queueTail.load(std::memory_order_relaxed);
+    if (tail == queueHead.load(std::memory_order_acquire)) {
+        return false;
+    }
+
+    event = queue[tail];
+    queueTail.store((tail + 1) & (BUTTON_QUEUE_SIZE - 1), std::memory_order_release);
+    return true;
+}
+
+ButtonEvent ButtonHandler::check() {
+    if (!sampleTimer) {
+        sample(isTouched(), millis());
+    }
+
+    ButtonEventRecord event;
+    if (!nextEvent(event)) {
+        return NONE;
+    }
+
+    Serial.print("Button event after ");
+    Serial.print(event.duration);
+    Serial.print(" ms (");
+    Serial.print(millis() - event.time);
+    Serial.println(" ms ago)");
+
+    switch (event.type) {
+        case FACTORY_RESET:
+            Serial.println("Factory reset triggered");
+            break;
+        case LONG_PRESS:
+            Serial.println("Long press triggered (config mode)");
+            break;
+        case SHORT_PRESS:
+            Serial.println("Short press triggered (cycle module)");
+            break;
+        case DOUBLE_TAP:
+            Serial.println("Double tap triggered (previous module)");
+            break;
+        case REPEAT_PRESS:
+            Serial.println("Hold repeat triggered (cycle module)");
+            break;
+        default:
+            break;
+    }
+    return event.type;
+}
+
 bool ButtonHandler::isCurrentlyPressed() {
-    return isPressed;
+    return isHolding;
 }
 
 unsigned long ButtonHandler::getCurrentPressDuration() {
-    if (!isPressed) return 0;
-    return millis() - pressStartTime;
+    if (!isHolding) return 0;
+    return millis() - holdStartTime;
 }
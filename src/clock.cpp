@@ -0,0 +1,86 @@
+#include "clock.h"
+#include <esp_sntp.h>
+#include <atomic>
+
+// Last 32-bit millis() reading and the wraps seen so far. Every caller runs
+// on the loop task and the loop polls far more often than every 49 days,
+// so each wrap is seen as the counter going backwards exactly once.
+static uint32_t lastMillis = 0;
+static uint32_t millisWraps = 0;
+
+uint64_t uptimeMillis() {
+    uint32_t now = (uint32_t)millis();
+    if (now < lastMillis) {
+        millisWraps++;
+    }
+    lastMillis = now;
+    return ((uint64_t)millisWraps << 32) | now;
+}
+
+uint64_t uptimeSeconds() {
+    return UPTIME_SECONDS_BASE + uptimeMillis() / 1000;
+}
+
+uint64_t timeSince(uint64_t then, uint64_t now) {
+    if (then == TIME_NEVER) return TIME_NEVER;
+    return now > then ? now - then : 0;
+}
+
+// ============================================
+// Wall clock
+// ============================================
+
+// SNTP reports syncs from the lwIP task. The callback fills the hand-over
+// fields and raises syncPending; the loop task takes them on its next read
+// and clears it. A sync that arrives while one is still pending is dropped
+// (the next one, an hour later, gets through).
+static std::atomic<bool> syncPending(false);
+static uint32_t pendingEpoch = 0;
+static uint32_t pendingMillis = 0;
+
+// Unix time at uptimeMillis() == syncUptime (loop task only)
+static uint32_t syncEpoch = 0;
+static uint64_t syncUptime = 0;
+
+static void onTimeSync(struct timeval* tv) {
+    if (!tv || tv->tv_sec < (time_t)WALL_CLOCK_MIN || syncPending.load(std::memory_order_acquire)) {
+        return;
+    }
+    pendingEpoch = (uint32_t)tv->tv_sec;
+    pendingMillis = (uint32_t)millis();
+    syncPending.store(true, std::memory_order_release);
+}
+
+static void applyPendingSync() {
+    if (!syncPending.load(std::memory_order_acquire)) {
+        return;
+    }
+
+    // Refer the sync back to the moment SNTP reported it
+    uint64_t now = uptimeMillis();
+    uint32_t age = (uint32_t)now - pendingMillis;
+    bool first = (syncEpoch == 0);
+    syncEpoch = pendingEpoch;
+    syncUptime = now - age;
+    syncPending.store(false, std::memory_order_release);
+
+    if (first) {
+        Serial.print("Wall clock synced: ");
+        Serial.println(syncEpoch);
+    }
+}
+
+void startWallClock() {
+    sntp_set_time_sync_notification_cb(onTimeSync);
+    configTime(0, 0, NTP_SERVER_1, NTP_SERVER_2);
+}
+
+bool wallClockValid() {
+    applyPendingSync();
+    return syncEpoch != 0;
+}
+
+uint32_t wallClockSeconds() {
+    if (!wallClockValid()) return 0;
+    return syncEpoch + (uint32_t)((uptimeMillis() - syncUptime) / 1000);
+}
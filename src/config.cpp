@@ -1,49 +1,73 @@
 #include "config.h"
 
 // Global configuration document (StaticJsonDocument allocated in .bss, not heap)
-// Increased to 2KB to accommodate all crypto fields
+// Holds settings only; live readings are in moduleCache
 StaticJsonDocument<2048> config;
 
 // Track last save time to reduce flash wear
-static unsigned long lastSaveTime = 0;
+static uint64_t lastSaveTime = TIME_NEVER;
 #define MIN_SAVE_INTERVAL 30000  // Minimum 30s between saves
 
-bool initStorage() {
-    Serial.println("Initializing LittleFS...");
+// Config file layout: header followed by the MessagePack-encoded document
+#define CONFIG_MAGIC 0x46434444  // "DDCF"
+
+struct ConfigFileHeader {
+    uint32_t magic;
+    uint16_t version;   // CONFIG_SCHEMA_VERSION the document was written with
+    uint16_t reserved;
+    uint32_t size;      // Payload bytes after the header
+};
+
+// Swap a fully written temp file into place. LittleFS renames atomically,
+// so a power loss leaves either the old or the new file, never a torn one.
+static bool replaceFile(const char* tmpPath, const char* path) {
+    if (LittleFS.rename(tmpPath, path)) {
+        return true;
+    }
 
-    // Try to mount first
-    if (!LittleFS.begin(false)) {
-        Serial.println("LittleFS mount failed, formatting...");
-        // Format if mount fails
-        if (!LittleFS.begin(true)) {
-            Serial.println("ERROR: LittleFS format failed");
-            return false;
-        }
-        Serial.println("LittleFS formatted successfully");
+    // Fallback for filesystems that refuse to rename over an existing file;
+    // if power fails in between, loadConfiguration() recovers the temp file
+    LittleFS.remove(path);
+    return LittleFS.rename(tmpPath, path);
+}
+
+static bool readConfigFile(const char* path, uint16_t& version) {
+    File file = LittleFS.open(path, "r");
+    if (!file) {
+        return false;
     }
 
-    Serial.println("LittleFS mounted successfully");
+    ConfigFileHeader header;
+    bool valid = file.read((uint8_t*)&header, sizeof(header)) == sizeof(header) &&
+                 header.magic == CONFIG_MAGIC &&
+                 header.size == file.size() - sizeof(header);
+    if (!valid) {
+        file.close();
+        Serial.print("Invalid config file: ");
+        Serial.println(path);
+        return false;
+    }
 
-    // Create config file if it doesn't exist
-    if (!LittleFS.exists(CONFIG_FILE)) {
-        Serial.println("Creating default config file...");
-        File file = LittleFS.open(CONFIG_FILE, "w");
-        if (file) {
-            file.print("{}");  // Empty JSON object
-            file.close();
-            Serial.println("Default config file created");
-        }
+    DeserializationError error = deserializeMsgPack(config, file);
+    file.close();
+
+    if (error) {
+        Serial.print("Failed to parse ");
+        Serial.print(path);
+        Serial.print(": ");
+        Serial.println(error.c_str());
+        return false;
     }
 
+    version = header.version;
     return true;
 }
 
-bool loadConfiguration() {
-    File file = LittleFS.open(CONFIG_FILE, "r");
+// JSON is only an interchange format: a file uploaded with the filesystem
+// image (or left by older firmware) is imported once and then removed
+static bool importConfigFile(const char* path) {
+    File file = LittleFS.open(path, "r");
     if (!file) {
-        Serial.println("Config file not found, creating default config");
-        setDefaultConfig();
-        saveConfiguration();
         return false;
     }
 
@@ -51,14 +75,27 @@ bool loadConfiguration() {
     file.close();
 
     if (error) {
-        Serial.print("Failed to parse config: ");
+        Serial.print("Failed to import ");
+        Serial.print(path);
+        Serial.print(": ");
         Serial.println(error.c_str());
-        setDefaultConfig();
-        saveConfiguration();
         return false;
     }
+    return true;
+}
 
-    Serial.println("Configuration loaded successfully");
+// ============================================
+// Schema migrations
+// ============================================
+
+// Schema history:
+//   1 - JSON config, readings stored alongside settings
+//   2 - MessagePack config, readings moved to CACHE_FILE
+static void migrateV1toV2() {
+    // Older firmware kept readings in the config; they now live in CACHE_FILE
+    if (stripReadings()) {
+        Serial.println("Removed cached readings from config");
+    }
 
     // Check if essential fields exist, populate defaults if missing
     bool needsDefaults = false;
@@ -80,10 +117,104 @@ bool loadConfiguration() {
 
     if (needsDefaults) {
         setDefaultConfig();
-        saveConfiguration(true);  // Force save
-        Serial.println("Default config populated and saved");
+    }
+}
+
+// configMigrations[n - 1] upgrades a document from version n to n + 1
+typedef void (*ConfigMigration)();
+static const ConfigMigration configMigrations[CONFIG_SCHEMA_VERSION - 1] = {
+    migrateV1toV2
+};
+
+static void migrateConfig(uint16_t fromVersion) {
+    if (fromVersion < 1) fromVersion = 1;
+    for (uint16_t v = fromVersion; v < CONFIG_SCHEMA_VERSION; v++) {
+        Serial.print("Migrating config schema ");
+        Serial.print(v);
+        Serial.print(" -> ");
+        Serial.println(v + 1);
+        configMigrations[v - 1]();
+    }
+}
+
+// ============================================
+// Load / save
+// ============================================
+
+bool initStorage() {
+    Serial.println("Initializing LittleFS...");
+
+    // Try to mount first
+    if (!LittleFS.begin(false)) {
+        Serial.println("LittleFS mount failed, formatting...");
+        // Format if mount fails
+        if (!LittleFS.begin(true)) {
+            Serial.println("ERROR: LittleFS format failed");
+            return false;
+        }
+        Serial.println("LittleFS formatted successfully");
+    }
+
+    Serial.println("LittleFS mounted successfully");
+    return true;
+}
+
+bool loadConfiguration() {
+    uint32_t startUs = micros();
+    uint16_t version = 0;
+    bool loaded = false;
+    bool imported = false;
+
+    if (LittleFS.exists(CONFIG_IMPORT_FILE)) {
+        imported = importConfigFile(CONFIG_IMPORT_FILE);
+        if (imported) {
+            Serial.println("Importing " CONFIG_IMPORT_FILE);
+            loaded = true;
+            version = 1;  // Run every migration; each one tolerates current data
+        } else {
+            LittleFS.remove(CONFIG_IMPORT_FILE);
+        }
+    }
+
+    // A leftover temp file means a save was interrupted. If it parses it is
+    // the newest config, so finish the rename; otherwise it is discarded.
+    if (!loaded && LittleFS.exists(CONFIG_TMP_FILE)) {
+        loaded = readConfigFile(CONFIG_TMP_FILE, version);
+        if (loaded) {
+            Serial.println("Completing interrupted config save");
+            replaceFile(CONFIG_TMP_FILE, CONFIG_FILE);
+        } else {
+            LittleFS.remove(CONFIG_TMP_FILE);
+        }
+    }
+
+    if (!loaded) {
+        loaded = readConfigFile(CONFIG_FILE, version);
+    }
+
+    if (!loaded) {
+        Serial.println("No valid config file, creating default config");
+        setDefaultConfig();
+        saveConfiguration(true);
+        return false;
     }
 
+    if (version > CONFIG_SCHEMA_VERSION) {
+        Serial.print("WARNING: Config schema ");
+        Serial.print(version);
+        Serial.println(" is newer than this firmware, unknown fields are ignored");
+    } else if (version < CONFIG_SCHEMA_VERSION) {
+        migrateConfig(version);
+        if (saveConfiguration(true) && imported) {
+            LittleFS.remove(CONFIG_IMPORT_FILE);
+        }
+    }
+    loadModuleLabels();
+
+    Serial.print("Configuration loaded successfully in ");
+    Serial.print(micros() - startUs);
+    Serial.println(" us");
+
     // Debug: Show what was loaded for crypto modules
     Serial.println("=== Loaded Config (Crypto Modules) ===");
     JsonObject bitcoin = config["modules"]["bitcoin"];
@@ -118,8 +249,8 @@ bool loadConfiguration() {
 
 bool saveConfiguration(bool force) {
     // Throttle saves to reduce flash wear (unless forced)
-    unsigned long now = millis();
-    if (!force && now - lastSaveTime < MIN_SAVE_INTERVAL) {
+    uint64_t now = uptimeMillis();
+    if (!force && timeSince(lastSaveTime, now) < MIN_SAVE_INTERVAL) {
         Serial.println("Skipping save (too soon since last save)");
         return true;  // Not an error, just throttled
     }
@@ -128,21 +259,35 @@ bool saveConfiguration(bool force) {
         Serial.println("FORCED SAVE - bypassing throttle");
     }
 
-    File file = LittleFS.open(CONFIG_FILE, "w");
+    // Write the new config beside the old one, then swap it in
+    File file = LittleFS.open(CONFIG_TMP_FILE, "w");
     if (!file) {
         Serial.println("ERROR: Failed to open config file for writing");
         return false;
     }
 
-    if (serializeJson(config, file) == 0) {
+    ConfigFileHeader header = { CONFIG_MAGIC, CONFIG_SCHEMA_VERSION, 0, (uint32_t)measureMsgPack(config) };
+    size_t written = 0;
+    if (file.write((const uint8_t*)&header, sizeof(header)) == sizeof(header)) {
+        written = serializeMsgPack(config, file);
+    }
+    file.close();
+
+    if (written == 0 || written != header.size) {
         Serial.println("ERROR: Failed to write config");
-        file.close();
+        LittleFS.remove(CONFIG_TMP_FILE);
+        return false;
+    }
+
+    if (!replaceFile(CONFIG_TMP_FILE, CONFIG_FILE)) {
+        Serial.println("ERROR: Failed to replace config file");
         return false;
     }
 
-    file.close();
     lastSaveTime = now;
-    Serial.println("Configuration saved successfully");
+    Serial.print("Configuration saved successfully (");
+    Serial.print(sizeof(header) + written);
+    Serial.println(" bytes)");
 
     // Debug: Show what was saved for crypto modules
     Serial.println("=== Saved Config (Crypto Modules) ===");
@@ -194,88 +339,333 @@ void setDefaultConfig() {
     bitcoin["cryptoId"] = "bitcoin";
     bitcoin["cryptoSymbol"] = "BTC";
     bitcoin["cryptoName"] = "Bitcoin";
-    bitcoin["value"] = 0.0;
-    bitcoin["change24h"] = 0.0;
-    bitcoin["lastUpdate"] = 0;
-    bitcoin["lastSuccess"] = false;
 
     JsonObject ethereum = config["modules"]["ethereum"].to<JsonObject>();
     ethereum["cryptoId"] = "ethereum";
     ethereum["cryptoSymbol"] = "ETH";
     ethereum["cryptoName"] = "Ethereum";
-    ethereum["value"] = 0.0;
-    ethereum["change24h"] = 0.0;
-    ethereum["lastUpdate"] = 0;
-    ethereum["lastSuccess"] = false;
 
     JsonObject stock = config["modules"]["stock"].to<JsonObject>();
     stock["ticker"] = "AAPL";
     stock["name"] = "Apple Inc.";
-    stock["value"] = 0.0;
-    stock["change"] = 0.0;
-    stock["lastUpdate"] = 0;
-    stock["lastSuccess"] = false;
 
     JsonObject weather = config["modules"]["weather"].to<JsonObject>();
     weather["latitude"] = 37.7749;
     weather["longitude"] = -122.4194;
     weather["location"] = "San Francisco";
-    weather["temperature"] = 0.0;
-    weather["condition"] = "Unknown";
-    weather["lastUpdate"] = 0;
-    weather["lastSuccess"] = false;
 
     JsonObject custom = config["modules"]["custom"].to<JsonObject>();
     custom["value"] = 0.0;
     custom["label"] = "My Metric";
     custom["unit"] = "units";
-    custom["lastUpdate"] = 0;
-    custom["lastSuccess"] = true;
+
+    // Readings start empty; labels follow the new settings
+    for (int i = 0; i < MODULE_SLOT_COUNT; i++) {
+        clearModuleCache((ModuleSlot)i);
+    }
+    moduleCache[SLOT_CUSTOM].lastSuccess = true;
+    loadModuleLabels();
 
     Serial.println("Default configuration created");
 }
 
-void updateModuleCache(const char* moduleId, JsonObject data) {
-    JsonObject module = config["modules"][moduleId];
+// ============================================
+// Module cache
+// ============================================
+
+ModuleCacheEntry moduleCache[MODULE_SLOT_COUNT];
+
+const ModuleId moduleCycleOrder[MODULE_CYCLE_COUNT] = {
+    MODULE_BITCOIN, MODULE_SETTINGS, MODULE_ETHEREUM, MODULE_STOCK, MODULE_WEATHER, MODULE_CUSTOM
+};
+
+// Snapshot file layout: header followed by MODULE_SLOT_COUNT entries
+#define CACHE_MAGIC 0x43544444  // "DDTC"
+#define CACHE_VERSION 3
+
+struct CacheSnapshotHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint8_t count;
+    uint8_t entrySize;
+};
+
+// Last snapshot written, to skip writes when nothing changed
+static ModuleCacheEntry savedCache[MODULE_SLOT_COUNT];
+static uint64_t lastSnapshotTime = TIME_NEVER;
+
+// Snapshot readings that carry a Unix timestamp, waiting for the wall clock
+static bool restorePending = false;
+
+// JSON field names per slot (nullptr = not stored)
+struct CacheLayout {
+    const char* valueKey;
+    const char* changeKey;
+    const char* detailKey;
+    const char* labelKey;
+    const char* labelDefault;
+};
+
+static const CacheLayout cacheLayout[MODULE_SLOT_COUNT] = {
+    { "value",       "change24h", nullptr,     "cryptoName", "Bitcoin" },    // Bitcoin
+    { "value",       "change24h", nullptr,     "cryptoName", "Ethereum" },   // Ethereum
+    { "value",       "change",    nullptr,     "ticker",     "STOCK" },      // Stock
+    { "temperature", nullptr,     "condition", "location",   "Unknown" },    // Weather
+    { "value",       nullptr,     nullptr,     "label",      "CUSTOM" }      // Custom
+};
+
+ModuleId getActiveModule() {
+    ModuleId id = findModule(config["device"]["activeModule"] | "bitcoin");
+    return (id == MODULE_NONE) ? MODULE_BITCOIN : id;
+}
+
+void setActiveModule(ModuleId id) {
+    config["device"]["activeModule"] = moduleName(id);
+}
+
+JsonObject moduleConfig(ModuleId id) {
+    JsonObject modules = config["modules"];
+    if (modules.isNull()) modules = config.createNestedObject("modules");
+    JsonObject section = modules[moduleName(id)];
+    if (section.isNull()) section = modules.createNestedObject(moduleName(id));
+    return section;
+}
+
+ModuleCacheEntry* getModuleCache(ModuleId id) {
+    return ((int)id < MODULE_SLOT_COUNT) ? &moduleCache[id] : nullptr;
+}
+
+void loadModuleLabels() {
+    for (int i = 0; i < MODULE_SLOT_COUNT; i++) {
+        const CacheLayout& layout = cacheLayout[i];
+        ModuleCacheEntry& entry = moduleCache[i];
+        JsonObject module = config["modules"][moduleName((ModuleId)i)];
+
+        strlcpy(entry.label, module[layout.labelKey] | layout.labelDefault, sizeof(entry.label));
+        strlcpy(entry.unit, module["unit"] | "", sizeof(entry.unit));
+    }
+
+    // Crypto headers are drawn in capitals
+    for (char* c = moduleCache[SLOT_BITCOIN].label; *c; c++) *c = toupper(*c);
+    for (char* c = moduleCache[SLOT_ETHEREUM].label; *c; c++) *c = toupper(*c);
+
+    // The custom value is entered by the user, so it is a setting
+    moduleCache[SLOT_CUSTOM].value = config["modules"]["custom"]["value"] | 0.0;
+}
+
+bool stripReadings() {
+    bool removed = false;
+    for (int i = 0; i < MODULE_SLOT_COUNT; i++) {
+        const CacheLayout& layout = cacheLayout[i];
+        JsonObject module = config["modules"][moduleName((ModuleId)i)];
+        if (module.isNull()) continue;
+
+        const char* keys[] = {
+            (i == SLOT_CUSTOM) ? nullptr : layout.valueKey,
+            layout.changeKey, layout.detailKey, "lastUpdate", "lastSuccess"
+        };
+        for (const char* key : keys) {
+            if (key && module.containsKey(key)) {
+                module.remove(key);
+                removed = true;
+            }
+        }
+    }
+
+    // Older firmware also kept the settings screen's security code here
+    JsonObject settings = config["modules"]["settings"];
+    if (!settings.isNull()) {
+        const char* keys[] = { "securityCode", "codeTimeRemaining", "lastUpdate", "lastSuccess" };
+        for (const char* key : keys) {
+            if (settings.containsKey(key)) {
+                settings.remove(key);
+                removed = true;
+            }
+        }
+    }
+    return removed;
+}
+
+void exportModuleCache(JsonObject out) {
+    for (int i = 0; i < MODULE_SLOT_COUNT; i++) {
+        const CacheLayout& layout = cacheLayout[i];
+        const ModuleCacheEntry& entry = moduleCache[i];
+        JsonObject module = out.createNestedObject(moduleName((ModuleId)i));
+
+        module[layout.valueKey] = entry.value;
+        if (layout.changeKey) module[layout.changeKey] = entry.change;
+        if (layout.detailKey) module[layout.detailKey] = (const char*)entry.detail;
+        if (entry.updatedAt) module["lastUpdate"] = entry.updatedAt;  // Unix time; absent = never or undated
+        module["lastSuccess"] = entry.lastSuccess;
+    }
+}
+
+bool loadCacheSnapshot() {
+    // Timestamps count from boot, so nothing has been updated yet
+    for (int i = 0; i < MODULE_SLOT_COUNT; i++) {
+        moduleCache[i].lastUpdate = TIME_NEVER;
+    }
+
+    File file = LittleFS.open(CACHE_FILE, "r");
+    if (!file) {
+        Serial.println("No cache snapshot");
+        return false;
+    }
+
+    CacheSnapshotHeader header;
+    ModuleCacheEntry entries[MODULE_SLOT_COUNT];
+    bool valid = file.read((uint8_t*)&header, sizeof(header)) == sizeof(header) &&
+                 header.magic == CACHE_MAGIC && header.version == CACHE_VERSION &&
+                 header.count == MODULE_SLOT_COUNT && header.entrySize == sizeof(ModuleCacheEntry) &&
+                 file.read((uint8_t*)entries, sizeof(entries)) == sizeof(entries);
+    file.close();
+
+    if (!valid) {
+        Serial.println("Cache snapshot invalid, ignoring");
+        return false;
+    }
+
+    // Restore readings only; labels and the custom value come from settings.
+    // lastUpdate stays TIME_NEVER until syncCacheTimestamps() can work out
+    // the reading's age from its Unix timestamp.
+    for (int i = 0; i < MODULE_SLOT_COUNT; i++) {
+        if (i == SLOT_CUSTOM) continue;
+        moduleCache[i].value = entries[i].value;
+        moduleCache[i].updatedAt = entries[i].updatedAt;
+        if (entries[i].updatedAt) restorePending = true;
+        moduleCache[i].change = entries[i].change;
+        moduleCache[i].lastSuccess = entries[i].lastSuccess;
+        memcpy(moduleCache[i].detail, entries[i].detail, sizeof(moduleCache[i].detail));
+        moduleCache[i].detail[CACHE_DETAIL_LEN - 1] = '\0';
+    }
+    memcpy(savedCache, moduleCache, sizeof(savedCache));
+
+    Serial.println("Cache snapshot restored");
+    return true;
+}
+
+bool saveCacheSnapshot(bool force) {
+    uint64_t now = uptimeMillis();
+    if (!force && timeSince(lastSnapshotTime, now) < CACHE_SNAPSHOT_INTERVAL) {
+        return true;
+    }
+    lastSnapshotTime = now;
 
-    // Update timestamp
-    module["lastUpdate"] = millis() / 1000;
-    module["lastSuccess"] = true;
+    if (memcmp(savedCache, moduleCache, sizeof(savedCache)) == 0) {
+        return true;  // Nothing new since the last snapshot
+    }
 
-    // Copy all data fields
-    for (JsonPair kv : data) {
-        module[kv.key()] = kv.value();
+    File file = LittleFS.open(CACHE_TMP_FILE, "w");
+    if (!file) {
+        Serial.println("ERROR: Failed to open cache snapshot for writing");
+        return false;
     }
 
-    // Request save (will be throttled if too frequent)
-    saveConfiguration();
+    CacheSnapshotHeader header = { CACHE_MAGIC, CACHE_VERSION, MODULE_SLOT_COUNT, sizeof(ModuleCacheEntry) };
+    bool ok = file.write((const uint8_t*)&header, sizeof(header)) == sizeof(header) &&
+              file.write((const uint8_t*)moduleCache, sizeof(moduleCache)) == sizeof(moduleCache);
+    file.close();
+
+    if (!ok || !replaceFile(CACHE_TMP_FILE, CACHE_FILE)) {
+        Serial.println("ERROR: Failed to write cache snapshot");
+        LittleFS.remove(CACHE_TMP_FILE);
+        return false;
+    }
+
+    memcpy(savedCache, moduleCache, sizeof(savedCache));
+    Serial.println("Cache snapshot saved");
+    return true;
+}
+
+void stampModuleCache(ModuleCacheEntry& entry) {
+    entry.lastUpdate = uptimeSeconds();
+    entry.updatedAt = wallClockSeconds();
+}
+
+bool cacheRestorePending() {
+    return restorePending;
+}
+
+void syncCacheTimestamps() {
+    static bool synced = false;
+    if (synced) return;
+
+    if (!wallClockValid()) {
+        if (restorePending && uptimeMillis() > CACHE_RESTORE_TIMEOUT) {
+            // No time source; restored readings are refetched as before
+            Serial.println("Wall clock not synced, restored readings left undated");
+            restorePending = false;
+        }
+        return;
+    }
+    synced = true;
+
+    uint32_t wallNow = wallClockSeconds();
+    uint64_t now = uptimeSeconds();
+    bool backfilled = false;
+    for (int i = 0; i < MODULE_SLOT_COUNT; i++) {
+        ModuleCacheEntry& entry = moduleCache[i];
+
+        if (entry.lastUpdate != TIME_NEVER) {
+            // Fetched this boot before the clock synced: give it a Unix time too
+            if (entry.updatedAt == 0) {
+                entry.updatedAt = wallNow - (uint32_t)timeSince(entry.lastUpdate, now);
+                backfilled = true;
+            }
+        } else if (restorePending && entry.updatedAt && entry.updatedAt <= wallNow) {
+            // Restored from before the reboot: place it in the past on the uptime
+            // clock so the scheduler refreshes it when it is due, not straight away
+            uint32_t age = wallNow - entry.updatedAt;
+            entry.lastUpdate = now - age;
+            Serial.print("Restored ");
+            Serial.print(moduleName((ModuleId)i));
+            Serial.print(" reading, ");
+            Serial.print(age);
+            Serial.println("s old");
+        }
+    }
+    restorePending = false;
+
+    // An undated snapshot would be no use after the next reboot
+    if (backfilled) {
+        saveCacheSnapshot(true);
+    }
+}
+
+void clearModuleCache(ModuleSlot slot) {
+    ModuleCacheEntry& entry = moduleCache[slot];
+    entry.value = 0.0;
+    entry.change = 0.0;
+    entry.lastUpdate = TIME_NEVER;
+    entry.updatedAt = 0;
+    entry.lastSuccess = false;
+    strlcpy(entry.detail, "Unknown", sizeof(entry.detail));
 }
 
-bool isCacheStale(const char* moduleId) {
-    JsonObject module = config["modules"][moduleId];
-    unsigned long lastUpdate = module["lastUpdate"] | 0;
-    unsigned long now = millis() / 1000;
+bool isCacheStale(ModuleId id) {
     uint16_t refreshInterval = config["device"]["refreshInterval"] | 300;
 
-    // Cache is stale if older than 2× refresh interval
-    return (now - lastUpdate) > (refreshInterval * 2);
+    // Cache is stale if older than 2× refresh interval (or never updated)
+    return getCacheAge(id) > (uint64_t)refreshInterval * 2;
 }
 
-unsigned long getCacheAge(const char* moduleId) {
-    JsonObject module = config["modules"][moduleId];
-    unsigned long lastUpdate = module["lastUpdate"] | 0;
-    unsigned long now = millis() / 1000;
-    return now - lastUpdate;
+uint64_t getCacheAge(ModuleId id) {
+    ModuleCacheEntry* entry = getModuleCache(id);
+    uint64_t lastUpdate = entry ? entry->lastUpdate : TIME_NEVER;
+    return timeSince(lastUpdate, uptimeSeconds());
 }
 
-String getTimeAgo(unsigned long timestamp) {
-    if (timestamp == 0) return "Never";
+const char* formatTimeAgo(uint64_t timestamp, char* out, size_t len) {
+    if (timestamp == TIME_NEVER) {
+        strlcpy(out, "Never", len);
+        return out;
+    }
 
-    unsigned long now = millis() / 1000;
-    unsigned long diff = now - timestamp;
+    unsigned long diff = (unsigned long)timeSince(timestamp, uptimeSeconds());
 
-    if (diff < 60) return String(diff) + "s ago";
-    if (diff < 3600) return String(diff / 60) + "m ago";
-    if (diff < 86400) return String(diff / 3600) + "h ago";
-    return String(diff / 86400) + "d ago";
+    if (diff < 60) snprintf(out, len, "%lus ago", diff);
+    else if (diff < 3600) snprintf(out, len, "%lum ago", diff / 60);
+    else if (diff < 86400) snprintf(out, len, "%luh ago", diff / 3600);
+    else snprintf(out, len, "%lud ago", diff / 86400);
+    return out;
 }
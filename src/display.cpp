@@ -2,8 +2,17 @@
 #include "config.h"
 #include <WiFi.h>
 
+// FNV-1a, continued from a previous hash value
+static uint32_t hashBytes(uint32_t hash, const void* data, size_t len) {
+    const uint8_t* bytes = (const uint8_t*)data;
+    for (size_t i = 0; i < len; i++) {
+        hash = (hash ^ bytes[i]) * 16777619u;
+    }
+    return hash;
+}
+
 DisplayManager::DisplayManager()
-    : u8g2(U8G2_R0, /* reset=*/ U8X8_PIN_NONE), currentState(SPLASH) {
+    : u8g2(U8G2_R0, /* reset=*/ U8X8_PIN_NONE), currentState(SPLASH), frameValid(false), stats(), renderKey(0), layoutText(), qrCache() {
 }
 
 void DisplayManager::init() {
@@ -14,6 +23,7 @@ void DisplayManager::init() {
 
     u8g2.begin();
     u8g2.enableUTF8Print();
+    frameValid = false;  // Panel RAM is unknown until the first full frame
     Serial.println("Display initialized");
 }
 
@@ -21,6 +31,44 @@ void DisplayManager::clear() {
     u8g2.clearBuffer();
 }
 
+// Push the frame buffer to the panel. After the first full frame only the
+// tiles that differ from the previous frame are sent, one run per page, so
+// a status bar tick costs a few tiles instead of the whole 1 KB buffer.
+void DisplayManager::flush() {
+    const uint8_t* buffer = u8g2.getBufferPtr();
+    stats.frames++;
+    renderKey = 0;  // showModule() sets it again for module screens
+
+    if (!frameValid) {
+        u8g2.sendBuffer();
+        memcpy(lastFrame, buffer, sizeof(lastFrame));
+        frameValid = true;
+        stats.fullFrames++;
+        stats.tilesSent += DISPLAY_TILE_COLS * DISPLAY_TILE_ROWS;
+        return;
+    }
+
+    for (uint8_t page = 0; page < DISPLAY_TILE_ROWS; page++) {
+        int first = -1;
+        int last = -1;
+        for (uint8_t tile = 0; tile < DISPLAY_TILE_COLS; tile++) {
+            size_t offset = (page * DISPLAY_TILE_COLS + tile) * 8;
+            if (memcmp(buffer + offset, lastFrame + offset, 8) != 0) {
+                if (first < 0) first = tile;
+                last = tile;
+            }
+        }
+
+        if (first >= 0) {
+            uint8_t width = last - first + 1;
+            u8g2.updateDisplayArea(first, page, width, 1);
+            stats.tilesSent += width;
+        }
+    }
+
+    memcpy(lastFrame, buffer, sizeof(lastFrame));
+}
+
 void DisplayManager::drawCenteredText(const char* text, int y, const uint8_t* font) {
     u8g2.setFont(font);
     int width = u8g2.getStrWidth(text);
@@ -38,7 +86,7 @@ void DisplayManager::drawHeader(const char* title) {
     u8g2.drawStr(2, 10, title);
 }
 
-void DisplayManager::drawStatusBar(bool wifiConnected, unsigned long lastUpdate, bool isStale) {
+void DisplayManager::drawStatusBar(bool wifiConnected, const char* timeAgo, bool isStale) {
     u8g2.setFont(u8g2_font_6x10_tr);
 
     // WiFi indicator
@@ -49,8 +97,7 @@ void DisplayManager::drawStatusBar(bool wifiConnected, unsigned long lastUpdate,
     }
 
     // Timestamp
-    String timeAgo = getTimeAgo(lastUpdate);
-    u8g2.drawStr(15, 62, timeAgo.c_str());
+    u8g2.drawStr(15, 62, timeAgo);
 
     // Stale indicator
     if (isStale) {
@@ -65,7 +112,7 @@ void DisplayManager::showSplash() {
     drawCenteredText("v2.6.12", 42, u8g2_font_6x10_tr);
     drawCenteredText("Revert", 54, u8g2_font_5x7_tr);
 
-    u8g2.sendBuffer();
+    flush();
     currentState = SPLASH;
 }
 
@@ -76,7 +123,7 @@ void DisplayManager::showConnecting(const char* ssid) {
     drawCenteredText(ssid, 40, u8g2_font_6x10_tr);
     drawCenteredText("Please wait...", 55, u8g2_font_6x10_tr);
 
-    u8g2.sendBuffer();
+    flush();
     currentState = CONNECTING;
 }
 
@@ -92,7 +139,7 @@ void DisplayManager::showConfigMode(const char* apName) {
 
     u8g2.drawStr(5, 57, "2. Open browser");
 
-    u8g2.sendBuffer();
+    flush();
     currentState = CONFIG_MODE;
 }
 
@@ -106,210 +153,178 @@ void DisplayManager::showError(const char* message) {
     int width = u8g2.getStrWidth(message);
     u8g2.drawStr((128 - width) / 2, 40, message);
 
-    u8g2.sendBuffer();
+    flush();
     currentState = ERROR_STATE;
 }
 
-void DisplayManager::showBitcoin(float price, float change24h, unsigned long lastUpdate, bool stale) {
-    // Get crypto name from config and convert to uppercase
-    JsonObject module = config["modules"]["bitcoin"];
-    String cryptoNameStr = module["cryptoName"] | "Bitcoin";
-    cryptoNameStr.toUpperCase();
-
-    u8g2.clearBuffer();
-
-    // Header with actual crypto name
-    drawHeader(cryptoNameStr.c_str());
-
-    // Price
-    char priceStr[16];
-    if (price >= 10000) {
-        snprintf(priceStr, sizeof(priceStr), "$%.0f", price);
-    } else if (price >= 1000) {
-        snprintf(priceStr, sizeof(priceStr), "$%.1f", price);
-    } else {
-        snprintf(priceStr, sizeof(priceStr), "$%.2f", price);
+// ============================================
+// Module screen templates
+// ============================================
+
+enum ValueFormat {
+    VALUE_PRICE,        // $ with fewer decimals as the price grows
+    VALUE_PRICE_WIDE,   // VALUE_PRICE with one decimal up to five digits
+    VALUE_CURRENCY,     // $ with two decimals
+    VALUE_NUMBER,       // Two decimals
+    VALUE_TEMPERATURE   // One decimal followed by a degree sign and C
+};
+
+enum LineSource {
+    LINE_NONE,
+    LINE_CHANGE,   // Arrow and percent change, then the template suffix
+    LINE_DETAIL,   // Cache detail (weather condition)
+    LINE_LABEL,    // Cache label (weather location)
+    LINE_UNIT      // Cache unit, omitted when empty
+};
+
+// Header, big value, sub-line, optional footer and the status bar. A new
+// module with a cache slot only needs a row in screenTemplates.
+struct ScreenTemplate {
+    const char* header;     // Fixed header, nullptr = cache label
+    ValueFormat value;
+    uint8_t valueY;
+    LineSource subline;     // helvB08
+    const char* suffix;     // Appended to LINE_CHANGE
+    uint8_t sublineY;
+    LineSource footer;      // 6x10
+    uint8_t footerY;
+    bool showStale;         // false for manual values that never go stale
+};
+
+static const ScreenTemplate screenTemplates[MODULE_SLOT_COUNT] = {
+    { nullptr,   VALUE_PRICE_WIDE,  38, LINE_CHANGE, "(24h)",   50, LINE_NONE,  0,  true },   // Bitcoin
+    { nullptr,   VALUE_PRICE,       38, LINE_CHANGE, "(24h)",   50, LINE_NONE,  0,  true },   // Ethereum
+    { nullptr,   VALUE_CURRENCY,    38, LINE_CHANGE, "(today)", 50, LINE_NONE,  0,  true },   // Stock
+    { "WEATHER", VALUE_TEMPERATURE, 35, LINE_DETAIL, nullptr,   46, LINE_LABEL, 56, true },   // Weather
+    { nullptr,   VALUE_NUMBER,      38, LINE_UNIT,   nullptr,   50, LINE_NONE,  0,  false }   // Custom
+};
+
+static void formatValue(ValueFormat format, float value, char* out, size_t len) {
+    switch (format) {
+        case VALUE_PRICE_WIDE:
+            if (value >= 10000) snprintf(out, len, "$%.0f", value);
+            else if (value >= 1000) snprintf(out, len, "$%.1f", value);
+            else snprintf(out, len, "$%.2f", value);
+            break;
+        case VALUE_PRICE:
+            if (value >= 1000) snprintf(out, len, "$%.0f", value);
+            else snprintf(out, len, "$%.2f", value);
+            break;
+        case VALUE_CURRENCY:
+            snprintf(out, len, "$%.2f", value);
+            break;
+        case VALUE_NUMBER:
+            snprintf(out, len, "%.2f", value);
+            break;
+        case VALUE_TEMPERATURE:
+            snprintf(out, len, "%.1f", value);
+            break;
     }
-    drawCenteredValue(priceStr, 38);
-
-    // Change percentage
-    u8g2.setFont(u8g2_font_helvB08_tr);
-    char changeStr[20];
-    const char* arrow = (change24h >= 0) ? "^" : "v";
-    snprintf(changeStr, sizeof(changeStr), "%s %.1f%% (24h)", arrow, fabs(change24h));
-    int changeWidth = u8g2.getStrWidth(changeStr);
-    u8g2.drawStr((128 - changeWidth) / 2, 50, changeStr);
-
-    // Status bar
-    drawStatusBar(WiFi.isConnected(), lastUpdate, stale);
-
-    u8g2.sendBuffer();
-    currentState = NORMAL;
 }
 
-void DisplayManager::showEthereum(float price, float change24h, unsigned long lastUpdate, bool stale) {
-    // Get crypto name from config and convert to uppercase
-    JsonObject module = config["modules"]["ethereum"];
-    String cryptoNameStr = module["cryptoName"] | "Ethereum";
-    cryptoNameStr.toUpperCase();
-
-    u8g2.clearBuffer();
-
-    // Header with actual crypto name
-    drawHeader(cryptoNameStr.c_str());
-
-    // Price
-    char priceStr[16];
-    if (price >= 1000) {
-        snprintf(priceStr, sizeof(priceStr), "$%.0f", price);
-    } else {
-        snprintf(priceStr, sizeof(priceStr), "$%.2f", price);
+// Text for a sub-line or footer; empty means the line is not drawn
+static void formatLine(LineSource source, const char* suffix, const ModuleCacheEntry& entry, char* out, size_t len) {
+    switch (source) {
+        case LINE_CHANGE:
+            snprintf(out, len, "%s %.1f%% %s", (entry.change >= 0) ? "^" : "v", fabs(entry.change), suffix);
+            break;
+        case LINE_DETAIL:
+            strlcpy(out, entry.detail, len);
+            break;
+        case LINE_LABEL:
+            strlcpy(out, entry.label, len);
+            break;
+        case LINE_UNIT:
+            strlcpy(out, entry.unit, len);
+            break;
+        default:
+            out[0] = '\0';
+            break;
     }
-    drawCenteredValue(priceStr, 38);
-
-    // Change percentage
-    u8g2.setFont(u8g2_font_helvB08_tr);
-    char changeStr[20];
-    const char* arrow = (change24h >= 0) ? "^" : "v";
-    snprintf(changeStr, sizeof(changeStr), "%s %.1f%% (24h)", arrow, fabs(change24h));
-    int changeWidth = u8g2.getStrWidth(changeStr);
-    u8g2.drawStr((128 - changeWidth) / 2, 50, changeStr);
-
-    // Status bar
-    drawStatusBar(WiFi.isConnected(), lastUpdate, stale);
-
-    u8g2.sendBuffer();
-    currentState = NORMAL;
 }
 
-void DisplayManager::showStock(const char* ticker, float price, float change, unsigned long lastUpdate, bool stale) {
-    u8g2.clearBuffer();
-
-    // Header with ticker
-    drawHeader(ticker);
-
-    // Price
-    char priceStr[16];
-    snprintf(priceStr, sizeof(priceStr), "$%.2f", price);
-    drawCenteredValue(priceStr, 38);
-
-    // Change percentage
-    u8g2.setFont(u8g2_font_helvB08_tr);
-    char changeStr[20];
-    const char* arrow = (change >= 0) ? "^" : "v";
-    snprintf(changeStr, sizeof(changeStr), "%s %.1f%% (today)", arrow, fabs(change));
-    int changeWidth = u8g2.getStrWidth(changeStr);
-    u8g2.drawStr((128 - changeWidth) / 2, 50, changeStr);
-
-    // Status bar
-    drawStatusBar(WiFi.isConnected(), lastUpdate, stale);
-
-    u8g2.sendBuffer();
-    currentState = NORMAL;
+u8g2_uint_t DisplayManager::measureText(LayoutText& cached, const char* text, const uint8_t* font) {
+    u8g2.setFont(font);
+    if (cached.font != font || strcmp(cached.text, text) != 0) {
+        strlcpy(cached.text, text, sizeof(cached.text));
+        cached.font = font;
+        cached.width = u8g2.getStrWidth(text);
+        stats.textMeasures++;
+    }
+    return cached.width;
 }
 
-void DisplayManager::showWeather(float temp, const char* condition, const char* location, unsigned long lastUpdate, bool stale) {
-    u8g2.clearBuffer();
-
-    // Header
-    drawHeader("WEATHER");
-
-    // Temperature
-    char tempStr[16];
-    snprintf(tempStr, sizeof(tempStr), "%.1f", temp);
-
-    u8g2.setFont(u8g2_font_logisoso24_tn);
-    int tempWidth = u8g2.getStrWidth(tempStr);
-    u8g2.drawStr((128 - tempWidth - 20) / 2, 35, tempStr);
-
-    // Degree symbol and C
-    u8g2.setFont(u8g2_font_helvB10_tr);
-    u8g2.drawStr((128 - tempWidth - 20) / 2 + tempWidth, 35, "C");
-    u8g2.drawCircle((128 - tempWidth - 20) / 2 + tempWidth - 3, 18, 2);
-
-    // Condition
-    u8g2.setFont(u8g2_font_helvB08_tr);
-    int condWidth = u8g2.getStrWidth(condition);
-    u8g2.drawStr((128 - condWidth) / 2, 46, condition);
-
-    // Location
-    u8g2.setFont(u8g2_font_6x10_tr);
-    int locWidth = u8g2.getStrWidth(location);
-    u8g2.drawStr((128 - locWidth) / 2, 56, location);
-
-    // Status bar
-    drawStatusBar(WiFi.isConnected(), lastUpdate, stale);
-
-    u8g2.sendBuffer();
-    currentState = NORMAL;
+void DisplayManager::drawLayoutLine(LayoutText& cached, const char* text, int y, const uint8_t* font) {
+    if (text[0] == '\0') return;
+    u8g2_uint_t width = measureText(cached, text, font);
+    u8g2.drawStr((128 - width) / 2, y, text);
 }
 
-void DisplayManager::showCustom(float value, const char* label, const char* unit, unsigned long lastUpdate) {
+void DisplayManager::renderModule(const ScreenTemplate& layout, const ModuleCacheEntry& entry, const char* timeAgo, bool stale) {
     u8g2.clearBuffer();
 
-    // Header with label
-    drawHeader(label);
+    drawHeader(layout.header ? layout.header : entry.label);
+
+    // Big value
+    char text[24];
+    formatValue(layout.value, entry.value, text, sizeof(text));
+    u8g2_uint_t width = measureText(layoutText[LAYOUT_VALUE], text, u8g2_font_logisoso24_tn);
+    if (layout.value == VALUE_TEMPERATURE) {
+        // Leave room for the degree sign and C
+        int x = (128 - width - 20) / 2;
+        u8g2.drawStr(x, layout.valueY, text);
+        u8g2.setFont(u8g2_font_helvB10_tr);
+        u8g2.drawStr(x + width, layout.valueY, "C");
+        u8g2.drawCircle(x + width - 3, 18, 2);
+    } else {
+        u8g2.drawStr((128 - width) / 2, layout.valueY, text);
+    }
 
-    // Value
-    char valueStr[16];
-    snprintf(valueStr, sizeof(valueStr), "%.2f", value);
-    drawCenteredValue(valueStr, 38);
+    formatLine(layout.subline, layout.suffix, entry, text, sizeof(text));
+    drawLayoutLine(layoutText[LAYOUT_SUBLINE], text, layout.sublineY, u8g2_font_helvB08_tr);
 
-    // Unit
-    if (strlen(unit) > 0) {
-        u8g2.setFont(u8g2_font_helvB08_tr);
-        int unitWidth = u8g2.getStrWidth(unit);
-        u8g2.drawStr((128 - unitWidth) / 2, 50, unit);
-    }
+    formatLine(layout.footer, nullptr, entry, text, sizeof(text));
+    drawLayoutLine(layoutText[LAYOUT_FOOTER], text, layout.footerY, u8g2_font_6x10_tr);
 
-    // Status bar (never stale for manual entry)
-    drawStatusBar(WiFi.isConnected(), lastUpdate, false);
+    drawStatusBar(WiFi.isConnected(), timeAgo, layout.showStale && stale);
 
-    u8g2.sendBuffer();
+    flush();
     currentState = NORMAL;
 }
 
-void DisplayManager::showModule(const char* moduleId) {
-    JsonObject module = config["modules"][moduleId];
-    unsigned long lastUpdate = module["lastUpdate"] | 0;
-    bool stale = isCacheStale(moduleId);
-
-    if (strcmp(moduleId, "bitcoin") == 0) {
-        float price = module["value"] | 0.0;
-        float change = module["change24h"] | 0.0;
-        const char* cryptoName = module["cryptoName"] | "Bitcoin";
-        Serial.print("Bitcoin module - Name: ");
-        Serial.print(cryptoName);
-        Serial.print(", Price: $");
-        Serial.println(price);
-        showBitcoin(price, change, lastUpdate, stale);
-    }
-    else if (strcmp(moduleId, "ethereum") == 0) {
-        float price = module["value"] | 0.0;
-        float change = module["change24h"] | 0.0;
-        showEthereum(price, change, lastUpdate, stale);
-    }
-    else if (strcmp(moduleId, "stock") == 0) {
-        const char* ticker = module["ticker"] | "STOCK";
-        float price = module["value"] | 0.0;
-        float change = module["change"] | 0.0;
-        showStock(ticker, price, change, lastUpdate, stale);
-    }
-    else if (strcmp(moduleId, "weather") == 0) {
-        float temp = module["temperature"] | 0.0;
-        const char* condition = module["condition"] | "Unknown";
-        const char* location = module["location"] | "Unknown";
-        showWeather(temp, condition, location, lastUpdate, stale);
-    }
-    else if (strcmp(moduleId, "custom") == 0) {
-        float value = module["value"] | 0.0;
-        const char* label = module["label"] | "CUSTOM";
-        const char* unit = module["unit"] | "";
-        showCustom(value, label, unit, lastUpdate);
-    }
-    else {
+void DisplayManager::showModule(ModuleId id) {
+    if ((int)id >= MODULE_SLOT_COUNT) {
         showError("Unknown module");
+        return;
     }
+
+    uint8_t slot = id;
+    const ModuleCacheEntry& module = moduleCache[slot];
+    bool stale = isCacheStale(id);
+    bool wifiConnected = WiFi.isConnected();
+
+    // Everything the screen shows; if none of it changed, neither did the frame
+    char timeAgo[TIME_AGO_LEN];
+    formatTimeAgo(module.lastUpdate, timeAgo, sizeof(timeAgo));
+    uint32_t key = 2166136261u;
+    key = hashBytes(key, &slot, sizeof(slot));
+    key = hashBytes(key, &module.value, sizeof(module.value));
+    key = hashBytes(key, &module.change, sizeof(module.change));
+    key = hashBytes(key, module.detail, strlen(module.detail));
+    key = hashBytes(key, module.label, strlen(module.label) + 1);
+    key = hashBytes(key, module.unit, strlen(module.unit) + 1);
+    key = hashBytes(key, timeAgo, strlen(timeAgo));
+    key = hashBytes(key, &stale, sizeof(stale));
+    key = hashBytes(key, &wifiConnected, sizeof(wifiConnected));
+    if (key == 0) key = 1;
+
+    if (key == renderKey) {
+        stats.skipped++;
+        return;
+    }
+
+    renderModule(screenTemplates[slot], module, timeAgo, stale);
+    renderKey = key;
 }
 
 void DisplayManager::showButtonStatus(bool isPressed, int digitalValue, int analogValue) {
@@ -337,23 +352,41 @@ void DisplayManager::showButtonStatus(bool isPressed, int digitalValue, int anal
     snprintf(buffer, sizeof(buffer), "Analog: %d", analogValue);
     u8g2.drawStr(2, 60, buffer);
 
-    u8g2.sendBuffer();
+    flush();
 }
 
-void DisplayManager::drawQRCode(const char* data, int x, int y, int scale) {
-    // Create QR code
-    QRCode qrcode;
-    uint8_t qrcodeData[qrcode_getBufferSize(3)];  // Version 3
-    qrcode_initText(&qrcode, qrcodeData, 3, ECC_LOW, data);
-
-    // Draw each module as a filled box
-    for (uint8_t qy = 0; qy < qrcode.size; qy++) {
-        for (uint8_t qx = 0; qx < qrcode.size; qx++) {
-            if (qrcode_getModule(&qrcode, qx, qy)) {
-                u8g2.drawBox(x + (qx * scale), y + (qy * scale), scale, scale);
+// QR encoding (Reed-Solomon plus one box per module) only runs when the
+// payload changes; otherwise the cached bitmap is blitted with one drawXBM
+void DisplayManager::drawQRCode(QRSlot slot, const char* data, int x, int y) {
+    QRBitmap& cache = qrCache[slot];
+
+    // Compared in full: a hash match is not proof the code is the same.
+    // Payloads too long to store are encoded every time.
+    if (!cache.valid || strcmp(cache.payload, data) != 0) {
+        QRCode qrcode;
+        uint8_t qrcodeData[qrcode_getBufferSize(QR_VERSION)];
+        qrcode_initText(&qrcode, qrcodeData, QR_VERSION, ECC_LOW, data);
+
+        // XBM rows are LSB-first, padded to whole bytes
+        const int stride = (QR_PIXELS + 7) / 8;
+        memset(cache.bits, 0, sizeof(cache.bits));
+        for (uint8_t qy = 0; qy < qrcode.size; qy++) {
+            for (uint8_t qx = 0; qx < qrcode.size; qx++) {
+                if (!qrcode_getModule(&qrcode, qx, qy)) continue;
+                for (int dy = 0; dy < QR_SCALE; dy++) {
+                    for (int dx = 0; dx < QR_SCALE; dx++) {
+                        int px = qx * QR_SCALE + dx;
+                        int py = qy * QR_SCALE + dy;
+                        cache.bits[py * stride + px / 8] |= 1 << (px % 8);
+                    }
+                }
             }
         }
+        cache.valid = strlen(data) <= QR_MAX_PAYLOAD;
+        if (cache.valid) strcpy(cache.payload, data);
     }
+
+    u8g2.drawXBM(x, y, QR_PIXELS, QR_PIXELS, cache.bits);
 }
 
 void DisplayManager::showWiFiQR(const char* ssid, const char* password) {
@@ -365,7 +398,7 @@ void DisplayManager::showWiFiQR(const char* ssid, const char* password) {
     // Draw QR code on RIGHT side
     // QR Version 3 = 29x29 modules, scale 2 = 58x58 pixels
     // Position: x=70 (right side), y=3 (vertically centered)
-    drawQRCode(qrData.c_str(), 70, 3, 2);
+    drawQRCode(QR_WIFI, qrData.c_str(), 70, 3);
 
     // Draw info on LEFT side with plenty of space
     u8g2.setFont(u8g2_font_helvB08_tr);
@@ -379,33 +412,17 @@ void DisplayManager::showWiFiQR(const char* ssid, const char* password) {
     u8g2.drawStr(2, 48, String(ssid).c_str());
     u8g2.drawStr(2, 58, String(password).c_str());
 
-    u8g2.sendBuffer();
+    flush();
 }
 
 void DisplayManager::showURLQR() {
     u8g2.clearBuffer();
 
     // Create URL QR code - shorter URL
-    String qrData = "http://dt.local";
-
-    // Draw QR code on RIGHT side - same size as Step 1
-    // QR Version 3 = 29x29 modules, scale 2 = 58x58 pixels (same as WiFi QR)
-    // Position: x=70 (right side, same as WiFi QR), y=3 (vertically centered)
-    QRCode qrcode;
-    uint8_t qrcodeData[qrcode_getBufferSize(3)];  // Version 3 (same as WiFi QR)
-    qrcode_initText(&qrcode, qrcodeData, 3, ECC_LOW, qrData.c_str());
-
-    // Draw QR on right side - same position and scale as WiFi QR
-    int qrX = 70;  // Right side (same as Step 1)
-    int qrY = 3;   // Vertically centered (same as Step 1)
-    int scale = 2; // Same scale as Step 1
-    for (uint8_t qy = 0; qy < qrcode.size; qy++) {
-        for (uint8_t qx = 0; qx < qrcode.size; qx++) {
-            if (qrcode_getModule(&qrcode, qx, qy)) {
-                u8g2.drawBox(qrX + (qx * scale), qrY + (qy * scale), scale, scale);
-            }
-        }
-    }
+    const char* qrData = "http://dt.local";
+
+    // Draw QR code on RIGHT side - same size and position as Step 1
+    drawQRCode(QR_URL, qrData, 70, 3);
 
     // Draw info on LEFT side with plenty of space
     u8g2.setFont(u8g2_font_helvB08_tr);
@@ -419,7 +436,7 @@ void DisplayManager::showURLQR() {
     u8g2.setFont(u8g2_font_6x10_tr);
     u8g2.drawStr(2, 58, "dt.local");
 
-    u8g2.sendBuffer();
+    flush();
 }
 
 void DisplayManager::showModuleLoading(const char* moduleName, int progress) {
@@ -455,5 +472,27 @@ void DisplayManager::showModuleLoading(const char* moduleName, int progress) {
     int percentWidth = u8g2.getStrWidth(percentStr);
     u8g2.drawStr((128 - percentWidth) / 2, 60, percentStr);
 
-    u8g2.sendBuffer();
+    flush();
+}
+
+void DisplayManager::showHoldProgress(const char* action, const char* hint, int progress) {
+    u8g2.clearBuffer();
+
+    drawCenteredText(action, 14, u8g2_font_helvB08_tr);
+
+    // Progress bar
+    int barWidth = 100;
+    int barHeight = 12;
+    int barX = (128 - barWidth) / 2;
+    int barY = 24;
+    u8g2.drawFrame(barX, barY, barWidth, barHeight);
+
+    int fillWidth = (barWidth - 4) * progress / 100;
+    if (fillWidth > 0) {
+        u8g2.drawBox(barX + 2, barY + 2, fillWidth, barHeight - 4);
+    }
+
+    drawCenteredText(hint, 54, u8g2_font_6x10_tr);
+
+    flush();
 }
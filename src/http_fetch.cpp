@@ -0,0 +1,437 @@
+#include "http_fetch.h"
+
+// chunkRemaining markers while decoding Transfer-Encoding: chunked
+#define CHUNK_SIZE_LINE -1   // Reading "<hex size>\r\n"
+#define CHUNK_DATA_END  -2   // Skipping the CRLF after chunk data
+
+#define MAX_LINE_LENGTH 512
+
+// connectResult and bodyResult values
+#define TASK_RUNNING 0
+#define TASK_OK      1
+#define TASK_FAILED  2
+
+// The response body as a Stream for the BodyReader, used on the body task
+class HttpBodyStream : public Stream {
+public:
+    explicit HttpBodyStream(HttpFetch& fetch) : fetch(fetch), pos(0), len(0) {
+        setTimeout(0);  // read() already waits; -1 means the body has ended
+    }
+
+    int available() override { return (int)(len - pos); }
+    int read() override { return fill() ? buffer[pos++] : -1; }
+    int peek() override { return fill() ? buffer[pos] : -1; }
+    size_t write(uint8_t c) override { return 0; }
+
+private:
+    HttpFetch& fetch;
+    uint8_t buffer[FETCH_READ_CHUNK];
+    size_t pos;
+    size_t len;
+
+    bool fill() {
+        if (pos < len) return true;
+        pos = 0;
+        len = fetch.readBody(buffer, sizeof(buffer));
+        return len > 0;
+    }
+};
+
+HttpFetch::HttpFetch()
+    : client(nullptr), state(FETCH_IDLE), port(443), startTime(0), reader(nullptr), readerArg(nullptr),
+      connecting(false), connectAbandoned(false), connectPort(0), connectResult(TASK_OK),
+      bodyResult(TASK_OK), bodyCancelled(false), bodyError(nullptr), bodyEnded(false),
+      bodyBytes(0), bodyReceived(0),
+      requestBytes(0), responseBytes(0),
+      statusCode(0), contentLength(-1), chunked(false), chunkRemaining(CHUNK_SIZE_LINE),
+      retryAfter(-1) {
+    memset(&stats, 0, sizeof(stats));
+    connectHost[0] = '\0';
+}
+
+HttpFetch::~HttpFetch() {
+    closeClient();
+}
+
+bool HttpFetch::parseUrl(const char* url) {
+    String u(url);
+    if (!u.startsWith("https://")) {
+        return false;
+    }
+
+    int hostStart = 8;  // strlen("https://")
+    int pathStart = u.indexOf('/', hostStart);
+    String hostPort = (pathStart < 0) ? u.substring(hostStart) : u.substring(hostStart, pathStart);
+    path = (pathStart < 0) ? String("/") : u.substring(pathStart);
+
+    int colon = hostPort.indexOf(':');
+    if (colon >= 0) {
+        host = hostPort.substring(0, colon);
+        port = hostPort.substring(colon + 1).toInt();
+    } else {
+        host = hostPort;
+        port = 443;
+    }
+
+    return host.length() > 0 && host.length() < HTTP_MAX_HOST_LEN && port > 0;
+}
+
+bool HttpFetch::begin(const char* url, BodyReader bodyReader, void* bodyReaderArg) {
+    abort();
+
+    if (!parseUrl(url)) {
+        error = "Invalid URL";
+        state = FETCH_FAILED;
+        return false;
+    }
+
+    requestBytes = 0;
+    responseBytes = 0;
+    statusCode = 0;
+    contentLength = -1;
+    chunked = false;
+    chunkRemaining = CHUNK_SIZE_LINE;
+    retryAfter = -1;
+    line = "";
+    error = "";
+    reader = bodyReader;
+    readerArg = bodyReaderArg;
+    startTime = millis();
+    state = FETCH_CONNECTING;
+    return true;
+}
+
+void HttpFetch::abort() {
+    closeClient();
+    state = FETCH_IDLE;
+    line = String();
+}
+
+void HttpFetch::closeAbandoned() {
+    connectRunning();  // Collects a connect nobody waits for any more
+}
+
+void HttpFetch::closeClient() {
+    // Still in use by the connect task; connectRunning() closes it later
+    if (connecting) {
+        connectAbandoned = true;
+        return;
+    }
+    if (state == FETCH_BODY) stopBody();
+
+    if (client) {
+        client->stop();
+        delete client;
+        client = nullptr;
+    }
+}
+
+bool HttpFetch::startConnect() {
+    client = new WiFiClientSecure;
+    if (!client) {
+        return false;
+    }
+    client->setInsecure();
+    client->setHandshakeTimeout(FETCH_TIMEOUT_MS / 1000);
+
+    // The task gets its own copy of the host: the next begin() may
+    // overwrite `host` before an abandoned connect finishes
+    strlcpy(connectHost, host.c_str(), sizeof(connectHost));
+    connectPort = port;
+    connectResult.store(TASK_RUNNING, std::memory_order_relaxed);
+    connecting = true;
+    connectAbandoned = false;
+    stats.handshakes++;
+    if (xTaskCreate(connectTask, "http_connect", HTTP_CONNECT_STACK, this,
+                    HTTP_TASK_PRIORITY, nullptr) != pdPASS) {
+        connecting = false;
+        closeClient();
+        return false;
+    }
+    return true;
+}
+
+void HttpFetch::connectTask(void* arg) {
+    // Connect task: touches nothing but the client until it posts the result
+    HttpFetch* fetch = static_cast<HttpFetch*>(arg);
+    bool connected = fetch->client->connect(fetch->connectHost, fetch->connectPort);
+    fetch->connectResult.store(connected ? TASK_OK : TASK_FAILED, std::memory_order_release);
+    vTaskDelete(nullptr);
+}
+
+bool HttpFetch::connectRunning() {
+    // Takes the client back once the connect task is done, closing it if
+    // the request that started the connect has given up on it
+    if (!connecting) return false;
+    if (connectResult.load(std::memory_order_acquire) == TASK_RUNNING) return true;
+
+    connecting = false;
+    if (connectAbandoned) {
+        connectAbandoned = false;
+        closeClient();
+    }
+    return false;
+}
+
+void HttpFetch::fail(const char* message) {
+    stats.lastRequestBytes = requestBytes + responseBytes;
+    stats.failures++;
+    closeClient();
+    error = message;
+    state = FETCH_FAILED;
+}
+
+void HttpFetch::finish() {
+    stats.lastRequestBytes = requestBytes + responseBytes;
+    stats.statusClasses[(statusCode >= 100 && statusCode < 600) ? statusCode / 100 : 0]++;
+    closeClient();
+    state = FETCH_DONE;
+}
+
+bool HttpFetch::readLine() {
+    // Accumulate into `line` until '\n'; returns true once a full line is there
+    while (client->available() > 0) {
+        int c = client->read();
+        if (c < 0) return false;
+        responseBytes++;
+        stats.bytesReceived++;
+        if (c == '\n') return true;
+        if (c != '\r') line += (char)c;
+        if (line.length() > MAX_LINE_LENGTH) {
+            fail("Header line too long");
+            return false;
+        }
+    }
+    return false;
+}
+
+void HttpFetch::handleHeader() {
+    int colon = line.indexOf(':');
+    if (colon < 0) return;
+
+    String name = line.substring(0, colon);
+    name.toLowerCase();
+    String value = line.substring(colon + 1);
+    value.trim();
+
+    if (name == "content-length") {
+        contentLength = value.toInt();
+    } else if (name == "transfer-encoding") {
+        value.toLowerCase();
+        chunked = (value.indexOf("chunked") >= 0);
+    } else if (name == "retry-after") {
+        // Delay in seconds; the HTTP-date form is left to the caller's default
+        if (value.length() > 0 && isdigit((unsigned char)value[0])) {
+            retryAfter = value.toInt();
+        }
+    }
+}
+
+size_t HttpFetch::decodeBody(uint8_t* data, size_t len) {
+    // Strips the chunked framing in place; returns how many body bytes are
+    // left at the front of data
+    if (!chunked) {
+        bodyBytes += len;
+        if (contentLength >= 0 && bodyBytes >= contentLength) bodyEnded = true;
+        return len;
+    }
+
+    size_t kept = 0;
+    size_t i = 0;
+    while (i < len && !bodyEnded) {
+        if (chunkRemaining == CHUNK_SIZE_LINE) {
+            char c = (char)data[i++];
+            if (c == '\n') {
+                long size = strtol(line.c_str(), nullptr, 16);
+                line = "";
+                if (size <= 0) {
+                    bodyEnded = true;  // Last chunk; trailers are ignored
+                } else {
+                    chunkRemaining = size;
+                }
+            } else if (c != '\r') {
+                line += c;
+            }
+        } else if (chunkRemaining == CHUNK_DATA_END) {
+            if (data[i] == '\n') chunkRemaining = CHUNK_SIZE_LINE;
+            i++;
+        } else {
+            size_t n = min(len - i, (size_t)chunkRemaining);
+            memmove(data + kept, data + i, n);
+            kept += n;
+            i += n;
+            bodyBytes += n;
+            chunkRemaining -= n;
+            if (chunkRemaining == 0) chunkRemaining = CHUNK_DATA_END;
+        }
+    }
+    return kept;
+}
+
+size_t HttpFetch::readBody(uint8_t* buffer, size_t size) {
+    // Body task: fills buffer with body bytes, waiting for the socket as
+    // long as the request has time left; 0 once the body is over
+    while (!bodyEnded && !bodyError) {
+        if (bodyCancelled.load(std::memory_order_relaxed)) {
+            bodyError = "Aborted";
+        } else if (millis() - startTime > FETCH_TIMEOUT_MS) {
+            bodyError = "Timeout";
+        } else if (client->available() > 0) {
+            // Never read past a Content-Length body
+            if (!chunked && contentLength >= 0) size = min(size, (size_t)(contentLength - bodyBytes));
+            int n = client->read(buffer, size);
+            if (n <= 0) continue;
+            responseBytes += n;
+            bodyReceived += n;
+            size_t kept = decodeBody(buffer, n);
+            if (kept > 0) return kept;
+        } else if (!client->connected()) {
+            // Without a length the body ends when the server closes
+            if (contentLength < 0 && !chunked) {
+                bodyEnded = true;
+            } else {
+                bodyError = "Connection closed";
+            }
+        } else {
+            delay(1);
+        }
+    }
+    return 0;
+}
+
+bool HttpFetch::startBody() {
+    bodyError = nullptr;
+    bodyEnded = (contentLength == 0 && !chunked);
+    bodyBytes = 0;
+    bodyReceived = 0;
+    bodyCancelled.store(false, std::memory_order_relaxed);
+    bodyResult.store(TASK_RUNNING, std::memory_order_relaxed);
+    if (xTaskCreate(bodyTask, "http_body", HTTP_BODY_STACK, this,
+                    HTTP_TASK_PRIORITY, nullptr) != pdPASS) {
+        bodyResult.store(TASK_OK, std::memory_order_relaxed);
+        return false;
+    }
+    return true;
+}
+
+void HttpFetch::bodyTask(void* arg) {
+    HttpFetch* fetch = static_cast<HttpFetch*>(arg);
+    {
+        HttpBodyStream body(*fetch);
+        fetch->reader(body, fetch->readerArg);
+    }
+    fetch->bodyResult.store(fetch->bodyError ? TASK_FAILED : TASK_OK, std::memory_order_release);
+    vTaskDelete(nullptr);
+}
+
+void HttpFetch::stopBody() {
+    // The task notices at its next read; parsing what it already has is quick
+    bodyCancelled.store(true, std::memory_order_relaxed);
+    while (bodyResult.load(std::memory_order_acquire) == TASK_RUNNING) {
+        delay(1);
+    }
+}
+
+FetchState HttpFetch::poll(uint16_t budgetMs) {
+    if (!isBusy()) {
+        return state;
+    }
+
+    uint32_t sliceStart = millis();
+    if (sliceStart - startTime > FETCH_TIMEOUT_MS) {
+        fail("Timeout");
+        return state;
+    }
+
+    switch (state) {
+        case FETCH_CONNECTING: {
+            // The connect task opens the connection while this state polls
+            // for the result. A connect abandoned by an earlier request has
+            // to finish first.
+            if (connectRunning()) return state;
+            if (!client) {
+                if (!startConnect()) fail("Connection failed");
+                return state;
+            }
+            if (connectResult.load(std::memory_order_relaxed) != TASK_OK) {
+                fail("Connection failed");
+                return state;
+            }
+            state = FETCH_SENDING;
+            return state;
+        }
+
+        case FETCH_SENDING: {
+            String request = "GET " + path + " HTTP/1.1\r\n";
+            request += "Host: " + host + "\r\n";
+            request += "User-Agent: DataTracker\r\n";
+            request += "Accept: application/json\r\n";
+            request += "Connection: close\r\n\r\n";
+            if (client->print(request) != request.length()) {
+                fail("Send failed");
+                return state;
+            }
+            requestBytes = request.length();
+            stats.requests++;
+            stats.bytesSent += requestBytes;
+            state = FETCH_STATUS;
+            return state;
+        }
+
+        case FETCH_BODY: {
+            // The body task feeds the reader and has its own timeout
+            if (bodyResult.load(std::memory_order_acquire) == TASK_RUNNING) return state;
+            stats.bytesReceived += bodyReceived;
+            if (bodyError) {
+                fail(bodyError);
+            } else {
+                finish();
+            }
+            return state;
+        }
+
+        default:
+            break;
+    }
+
+    // Status line and headers: read whatever has arrived, bounded by budget
+    while (isBusy() && millis() - sliceStart < budgetMs) {
+        if (client->available() <= 0) {
+            if (!client->connected()) fail("Connection closed");
+            break;
+        }
+
+        if (state == FETCH_STATUS) {
+            if (!readLine()) continue;
+            // "HTTP/1.1 200 OK"
+            int space = line.indexOf(' ');
+            statusCode = (space > 0) ? line.substring(space + 1).toInt() : 0;
+            line = "";
+            if (statusCode <= 0) {
+                fail("Malformed status line");
+                break;
+            }
+            state = FETCH_HEADERS;
+        } else if (state == FETCH_HEADERS) {
+            if (!readLine()) continue;
+            if (line.length() == 0) {
+                // End of headers; only a successful body is worth reading
+                line = "";
+                if (!reader || statusCode < 200 || statusCode >= 300) {
+                    finish();
+                    break;
+                }
+                if (!startBody()) {
+                    fail("Out of memory");
+                    break;
+                }
+                state = FETCH_BODY;
+                break;
+            }
+            handleHeader();
+            line = "";
+        }
+    }
+
+    return state;
+}
@@ -1,11 +1,15 @@
 #include <Arduino.h>
+#include <inttypes.h>
 #include "config.h"
 #include "display.h"
 #include "network.h"
 #include "scheduler.h"
 #include "button.h"
 #include "security.h"
+#include "memstats.h"
+#include "profiler.h"
 #include "modules/module_interface.h"
+#include "module_registry.h"
 
 // Include all module implementations
 #include "modules/bitcoin_module.cpp"
@@ -13,6 +17,18 @@
 #include "modules/stock_module.cpp"
 #include "modules/weather_module.cpp"
 #include "modules/custom_module.cpp"
+#include "modules/settings_module.cpp"
+
+// One instance per registered module, indexed by ModuleId
+#define MODULE_INSTANCE(name, id, type) static type module##name;
+MODULE_REGISTRY(MODULE_INSTANCE)
+#undef MODULE_INSTANCE
+
+ModuleInterface* const moduleTable[MODULE_COUNT] = {
+#define MODULE_ENTRY(name, id, type) &module##name,
+    MODULE_REGISTRY(MODULE_ENTRY)
+#undef MODULE_ENTRY
+};
 
 // Global objects
 DisplayManager display;
@@ -28,11 +44,12 @@ ButtonHandler button(BUTTON_PIN);
 bool configMode = false;
 ConfigQRState qrState = WAITING_FOR_CLIENT;  // Track QR display state
 bool buttonDebugMode = false;  // Button debug mode - disabled by default (use 'button' command to enable)
-unsigned long buttonDebugStartTime = 0;
-unsigned long lastDisplayUpdate = 0;
-unsigned long lastSerialCheck = 0;
-unsigned long lastSettingsCodeRefresh = 0;
-String lastDisplayedModule = "";  // Track which module is currently shown
+uint32_t buttonDebugStartTime = 0;  // millis() readings; differences survive the wrap
+uint32_t lastDisplayUpdate = 0;
+uint32_t lastSerialCheck = 0;
+uint32_t lastSettingsCodeRefresh = 0;
+ModuleId lastDisplayedModule = MODULE_NONE;  // Track which module is currently shown
+bool holdPreviewShown = false;    // Long-press progress is on the display
 #define DISPLAY_UPDATE_INTERVAL 1000  // Update display every 1s
 #define SERIAL_CHECK_INTERVAL 100     // Check serial every 100ms
 #define BUTTON_DEBUG_DURATION 30000   // Auto-disable after 30 seconds
@@ -41,7 +58,7 @@ String lastDisplayedModule = "";  // Track which module is currently shown
 
 // Function prototypes
 void handleButtonEvent(ButtonEvent event);
-void cycleToNextModule();
+void cycleModule(int step);
 void enterConfigMode();
 void confirmAndFactoryReset();
 void handleSerialCommand();
@@ -61,8 +78,9 @@ void setup() {
         }
     }
 
-    // Load configuration
+    // Load configuration, then the last readings snapshot
     loadConfiguration();
+    loadCacheSnapshot();
 
     // Initialize display
     display.init();
@@ -97,24 +115,23 @@ void setup() {
             Serial.println("WiFi connected successfully!");
             configMode = false;
 
+            // Wall clock for dating readings that survive a reboot
+            startWallClock();
+
             // Start settings web server (always available on local network)
             network.startSettingsServer();
 
-            // Initialize scheduler and register modules
+            // Initialize scheduler (modules come from MODULE_REGISTRY)
             scheduler.init();
-            scheduler.registerModule(new BitcoinModule());
-            scheduler.registerModule(new EthereumModule());
-            scheduler.registerModule(new StockModule());
-            scheduler.registerModule(new WeatherModule());
-            scheduler.registerModule(new CustomModule());
 
-            Serial.println("All modules registered");
-
-            // Force initial fetch of active module
-            String activeModule = config["device"]["activeModule"] | "bitcoin";
+            // Force initial fetch of active module, unless a restored reading
+            // may still be recent (the scheduler decides once it is dated)
+            ModuleId activeModule = getActiveModule();
             Serial.print("Active module: ");
-            Serial.println(activeModule);
-            scheduler.requestFetch(activeModule.c_str(), true);
+            Serial.println(moduleName(activeModule));
+            if (!cacheRestorePending()) {
+                scheduler.requestFetch(activeModule, true);
+            }
         } else {
             Serial.println("WiFi connection failed");
             Serial.println("Starting configuration AP mode...");
@@ -131,12 +148,12 @@ void setup() {
 }
 
 void loop() {
-    unsigned long now = millis();
+    uint32_t now = millis();
 
     // Handle config mode with adaptive QR display
     if (configMode) {
         // Check for client connection changes every 500ms
-        static unsigned long lastQRCheck = 0;
+        static uint32_t lastQRCheck = 0;
         if (now - lastQRCheck > QR_UPDATE_INTERVAL) {
             bool clientConnected = network.hasClientConnected();
 
@@ -160,11 +177,14 @@ void loop() {
         return;
     }
 
+    perfBeginLoop();
+
     // Check serial commands
     if (now - lastSerialCheck > SERIAL_CHECK_INTERVAL) {
         handleSerialCommand();
         lastSerialCheck = now;
     }
+    perfLap(PERF_SERIAL);
 
     // Button debug mode - show button status on display
     if (buttonDebugMode) {
@@ -194,7 +214,26 @@ void loop() {
         if (event != NONE) {
             handleButtonEvent(event);
         }
+
+        // Holding toward setup/reset: show how far along the press is
+        unsigned long held = button.getCurrentPressDuration();
+        if (held > SHORT_PRESS_MAX) {
+            if (held < LONG_PRESS_MIN) {
+                int progress = (held - SHORT_PRESS_MAX) * 100 / (LONG_PRESS_MIN - SHORT_PRESS_MAX);
+                display.showHoldProgress("SETUP MODE", "Keep holding...", progress);
+            } else {
+                int progress = min((held - LONG_PRESS_MIN) * 100 / (FACTORY_RESET_MIN - LONG_PRESS_MIN), 100UL);
+                display.showHoldProgress("FACTORY RESET", "Release for setup", progress);
+            }
+            holdPreviewShown = true;
+        } else if (holdPreviewShown) {
+            // Hold cancelled or handled; put the module screen back
+            holdPreviewShown = false;
+            lastDisplayedModule = MODULE_NONE;
+        }
     }
+    perfLap(PERF_BUTTON);
+    memSample(MEM_STAGE_BUTTON);
     #endif
 
     // Monitor WiFi connection
@@ -204,40 +243,58 @@ void loop() {
 
     // Handle settings web server requests (in normal operation mode)
     network.handleClient();
+    perfLap(PERF_WEB);
+    memSample(MEM_STAGE_WEB);
+
+    // Date restored readings once the wall clock is known
+    syncCacheTimestamps();
 
     // Run scheduler (fetch data if needed)
     scheduler.tick();
+    perfLap(PERF_SCHEDULER);
+    memSample(MEM_STAGE_SCHEDULER);
+
+    // Snapshot readings to flash (rate limited, skipped when unchanged)
+    saveCacheSnapshot();
+    perfLap(PERF_SNAPSHOT);
+    memSample(MEM_STAGE_SNAPSHOT);
 
     // Update display
-    String activeModule = config["device"]["activeModule"] | "bitcoin";
+    ModuleId activeModule = getActiveModule();
     bool moduleChanged = (activeModule != lastDisplayedModule);
 
-    // Settings module: refresh security code every 30 seconds
-    if (activeModule == "settings") {
-        if (moduleChanged) {
-            // First time showing settings - generate code immediately
-            scheduler.requestFetch("settings", true);
-            lastSettingsCodeRefresh = now;
-            display.showModule(activeModule.c_str());
-            lastDisplayedModule = activeModule;
-            lastDisplayUpdate = now;
-        } else if (now - lastSettingsCodeRefresh > SETTINGS_CODE_REFRESH) {
-            // Refresh code every 30 seconds while on settings screen
-            Serial.println("Refreshing security code (30s interval)");
-            scheduler.requestFetch("settings", true);
-            lastSettingsCodeRefresh = now;
-            display.showModule(activeModule.c_str());
-            lastDisplayUpdate = now;
-        }
-    } else {
-        // Other modules: update every 1 second for real-time data
-        bool shouldUpdate = moduleChanged || (now - lastDisplayUpdate > DISPLAY_UPDATE_INTERVAL);
-        if (shouldUpdate) {
-            display.showModule(activeModule.c_str());
-            lastDisplayedModule = activeModule;
-            lastDisplayUpdate = now;
+    // Long-press progress owns the display until the button is released
+    if (!holdPreviewShown) {
+        // Settings module: refresh security code every 30 seconds
+        if (activeModule == MODULE_SETTINGS) {
+            if (moduleChanged) {
+                // First time showing settings - generate code immediately
+                scheduler.requestFetch(MODULE_SETTINGS, true);
+                lastSettingsCodeRefresh = now;
+                display.showModule(activeModule);
+                lastDisplayedModule = activeModule;
+                lastDisplayUpdate = now;
+            } else if (now - lastSettingsCodeRefresh > SETTINGS_CODE_REFRESH) {
+                // Refresh code every 30 seconds while on settings screen
+                Serial.println("Refreshing security code (30s interval)");
+                scheduler.requestFetch(MODULE_SETTINGS, true);
+                lastSettingsCodeRefresh = now;
+                display.showModule(activeModule);
+                lastDisplayUpdate = now;
+            }
+        } else {
+            // Other modules: update every 1 second for real-time data
+            bool shouldUpdate = moduleChanged || (now - lastDisplayUpdate > DISPLAY_UPDATE_INTERVAL);
+            if (shouldUpdate) {
+                display.showModule(activeModule);
+                lastDisplayedModule = activeModule;
+                lastDisplayUpdate = now;
+            }
         }
     }
+    perfLap(PERF_DISPLAY);
+    perfEndLoop();
+    memSample(MEM_STAGE_DISPLAY);
 
     // Small delay to prevent watchdog
     delay(10);
@@ -246,7 +303,12 @@ void loop() {
 void handleButtonEvent(ButtonEvent event) {
     switch (event) {
         case SHORT_PRESS:
-            cycleToNextModule();
+        case REPEAT_PRESS:
+            cycleModule(1);
+            break;
+
+        case DOUBLE_TAP:
+            cycleModule(-1);
             break;
 
         case LONG_PRESS:
@@ -262,52 +324,37 @@ void handleButtonEvent(ButtonEvent event) {
     }
 }
 
-void cycleToNextModule() {
-    // Available modules (settings moved to 2nd position for easier access)
-    const char* modules[] = {"bitcoin", "settings", "ethereum", "stock", "weather", "custom"};
-    const int moduleCount = 6;
-
-    Serial.print("DEBUG: Total modules available: ");
-    Serial.println(moduleCount);
-    Serial.print("DEBUG: Module array: ");
-    for (int i = 0; i < moduleCount; i++) {
-        Serial.print(modules[i]);
-        if (i < moduleCount - 1) Serial.print(", ");
-    }
-    Serial.println();
+// Move step modules forward (negative = back) in the button cycle order
+void cycleModule(int step) {
+    const int moduleCount = MODULE_CYCLE_COUNT;
 
     // Find current module index
-    String currentModule = config["device"]["activeModule"] | "bitcoin";
-    int currentIndex = -1;
+    ModuleId currentModule = getActiveModule();
+    int currentIndex = 0;
     for (int i = 0; i < moduleCount; i++) {
-        if (currentModule == modules[i]) {
+        if (moduleCycleOrder[i] == currentModule) {
             currentIndex = i;
             break;
         }
     }
 
-    Serial.print("DEBUG: Current index: ");
-    Serial.println(currentIndex);
-
-    // Cycle to next (with wraparound)
-    int nextIndex = (currentIndex + 1) % moduleCount;
-    String nextModule = modules[nextIndex];
+    // Cycle in either direction (with wraparound)
+    int nextIndex = ((currentIndex + step) % moduleCount + moduleCount) % moduleCount;
+    ModuleId nextModule = moduleCycleOrder[nextIndex];
 
-    Serial.print("DEBUG: Next index: ");
-    Serial.println(nextIndex);
     Serial.print("Cycling from ");
-    Serial.print(currentModule);
+    Serial.print(moduleName(currentModule));
     Serial.print(" to ");
-    Serial.println(nextModule);
+    Serial.println(moduleName(nextModule));
 
-    config["device"]["activeModule"] = nextModule;
+    setActiveModule(nextModule);
 
     // Note: Settings code generation is now handled in main loop
     // Display will be updated automatically on next loop iteration
 
     // Schedule fetch if cache is stale (for non-settings modules)
-    if (nextModule != "settings") {
-        scheduler.requestFetch(nextModule.c_str(), false);
+    if (nextModule != MODULE_SETTINGS) {
+        scheduler.requestFetch(nextModule, false);
     }
 
     // Save active module to config (throttled)
@@ -377,6 +424,10 @@ void handleSerialCommand() {
         Serial.println("modules   - List available modules");
         Serial.println("switch    - Switch to next module");
         Serial.println("button    - Toggle button debug mode (shows on display)");
+        Serial.println("net       - Show HTTP connection counters");
+        Serial.println("display   - Show display transfer counters");
+        Serial.println("mem       - Show heap and stack usage");
+        Serial.println("perf      - Show loop stage timings (perf reset to clear)");
         Serial.println("==========================\n");
     }
     else if (cmd == "config") {
@@ -400,16 +451,95 @@ void handleSerialCommand() {
         }
         Serial.println("===================\n");
     }
+    else if (cmd == "net") {
+        const FetchStats& stats = scheduler.getFetchStats();
+        Serial.println("\n=== HTTP Connections ===");
+        Serial.print("Requests: ");
+        Serial.println(stats.requests);
+        Serial.print("TLS handshakes: ");
+        Serial.println(stats.handshakes);
+        Serial.print("Background refreshes: ");
+        Serial.println(scheduler.getBackgroundCount());
+        Serial.print("Bytes sent: ");
+        Serial.println(stats.bytesSent);
+        Serial.print("Bytes received: ");
+        Serial.println(stats.bytesReceived);
+        if (stats.requests > 0) {
+            Serial.print("Avg bytes/request: ");
+            Serial.println((stats.bytesSent + stats.bytesReceived) / stats.requests);
+        }
+        Serial.println("(HTTP payload only; TLS records and handshakes not included)");
+        Serial.println("========================\n");
+    }
+    else if (cmd == "display") {
+        const DisplayStats& stats = display.getStats();
+        Serial.println("\n=== Display Transfers ===");
+        Serial.print("Frames sent: ");
+        Serial.println(stats.frames);
+        Serial.print("Frames skipped: ");
+        Serial.println(stats.skipped);
+        Serial.print("Full frames: ");
+        Serial.println(stats.fullFrames);
+        Serial.print("Tiles sent: ");
+        Serial.println(stats.tilesSent);
+        Serial.print("Bytes sent: ");
+        Serial.println(stats.tilesSent * 8);
+        Serial.print("Text measurements: ");
+        Serial.println(stats.textMeasures);
+        if (stats.frames > 0) {
+            Serial.print("Avg bytes/frame: ");
+            Serial.println(stats.tilesSent * 8 / stats.frames);
+        }
+        Serial.println("=========================\n");
+    }
+    else if (cmd == "mem") {
+        MemSample current = memNow();
+        Serial.println("\n=== Memory ===");
+        Serial.printf("Free heap: %" PRIu32 " of %" PRIu32 " bytes\n", current.freeHeap, ESP.getHeapSize());
+        Serial.printf("Largest block: %" PRIu32 " bytes\n", current.largestBlock);
+        Serial.printf("Min free heap: %" PRIu32 " bytes (since boot)\n", memMinFreeHeap());
+        Serial.printf("Loop stack free: %" PRIu32 " bytes (high-water mark)\n", current.stackFree);
+        Serial.println("Worst after each stage since boot:");
+        Serial.println("  stage       samples  free heap  largest  stack");
+        for (uint8_t i = 0; i < MEM_STAGE_COUNT; i++) {
+            const MemStageStats& stats = memStageStats((MemStage)i);
+            if (stats.samples == 0) continue;
+            Serial.printf("  %-10s %8" PRIu32 " %10" PRIu32 " %8" PRIu32 " %6" PRIu32 "\n", memStageName((MemStage)i), stats.samples,
+                          stats.worst.freeHeap, stats.worst.largestBlock, stats.worst.stackFree);
+        }
+        Serial.println("==============\n");
+    }
+    else if (cmd == "perf") {
+        Serial.println("\n=== Loop Profile (us) ===");
+        Serial.println("  stage         count     min     avg     p99     max");
+        for (uint8_t i = 0; i < PERF_STAGE_COUNT; i++) {
+            PerfStage stage = (PerfStage)i;
+            const PerfStats& stats = perfStats(stage);
+            if (stats.count == 0) continue;
+            Serial.printf("  %-10s %8" PRIu32 " %7" PRIu32 " %7" PRIu32 " %7" PRIu32 " %7" PRIu32 "\n", perfStageName(stage), stats.count,
+                          perfCyclesToMicros(stats.minCycles),
+                          perfCyclesToMicros(stats.totalCycles / stats.count),
+                          perfPercentileMicros(stage, 99),
+                          perfCyclesToMicros(stats.maxCycles));
+        }
+        Serial.println("(p99 is a log2 bucket edge; 'perf reset' clears)");
+        Serial.println("=========================\n");
+    }
+    else if (cmd == "perf reset") {
+        perfReset();
+        Serial.println("Loop profile cleared");
+    }
     else if (cmd == "fetch") {
-        String activeModule = config["device"]["activeModule"] | "bitcoin";
+        ModuleId activeModule = getActiveModule();
         Serial.print("Forcing fetch for: ");
-        Serial.println(activeModule);
-        scheduler.requestFetch(activeModule.c_str(), true);
+        Serial.println(moduleName(activeModule));
+        scheduler.requestFetch(activeModule, true);
     }
     else if (cmd == "cache") {
         Serial.println("\n=== Cached Module Data ===");
-        JsonObject modules = config["modules"];
-        for (JsonPair kv : modules) {
+        DynamicJsonDocument readings(1024);
+        exportModuleCache(readings.to<JsonObject>());
+        for (JsonPair kv : readings.as<JsonObject>()) {
             Serial.print(kv.key().c_str());
             Serial.print(": ");
             serializeJson(kv.value(), Serial);
@@ -425,21 +555,19 @@ void handleSerialCommand() {
     }
     else if (cmd == "restart") {
         Serial.println("\nRestarting device...\n");
+        saveCacheSnapshot(true);
         delay(500);
         ESP.restart();
     }
     else if (cmd == "modules") {
         Serial.println("\n=== Available Modules ===");
-        Serial.println("1. bitcoin  - Bitcoin Price (BTC/USD)");
-        Serial.println("2. ethereum - Ethereum Price (ETH/USD)");
-        Serial.println("3. stock    - Stock Price (configurable)");
-        Serial.println("4. weather  - Weather Data (configurable)");
-        Serial.println("5. custom   - Custom Number (manual entry)");
-        Serial.println("6. settings - Settings & Configuration");
+        for (uint8_t i = 0; i < MODULE_COUNT; i++) {
+            Serial.printf("%u. %-8s - %s\n", i + 1, moduleNames[i], moduleTable[i]->displayName);
+        }
         Serial.println("=========================\n");
     }
     else if (cmd == "switch") {
-        cycleToNextModule();
+        cycleModule(1);
     }
     else if (cmd == "button") {
         if (buttonDebugMode) {
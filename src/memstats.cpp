@@ -0,0 +1,75 @@
+#include "memstats.h"
+
+static const char* const stageNames[MEM_STAGE_COUNT] = {
+    "button", "web", "scheduler", "snapshot", "display", "fetch"
+};
+
+static MemStageStats stageStats[MEM_STAGE_COUNT];
+
+MemSample memNow() {
+    MemSample sample;
+    sample.freeHeap = ESP.getFreeHeap();
+    sample.largestBlock = ESP.getMaxAllocHeap();
+    // ESP-IDF reports the high-water mark in bytes, not stack words
+    sample.stackFree = uxTaskGetStackHighWaterMark(NULL);
+    return sample;
+}
+
+void memSample(MemStage stage) {
+    MemStageStats& stats = stageStats[stage];
+    MemSample sample;
+    sample.freeHeap = ESP.getFreeHeap();
+    sample.stackFree = uxTaskGetStackHighWaterMark(NULL);
+
+    // Finding the largest block walks the whole heap; only pay for it on
+    // fetches and when this stage reaches a new low
+    bool newLow = stats.samples == 0 || sample.freeHeap < stats.worst.freeHeap;
+    if (stage == MEM_STAGE_FETCH || newLow) {
+        sample.largestBlock = ESP.getMaxAllocHeap();
+    } else {
+        sample.largestBlock = stats.last.largestBlock;
+    }
+
+    if (stats.samples == 0) {
+        stats.worst = sample;
+    } else {
+        stats.worst.freeHeap = min(stats.worst.freeHeap, sample.freeHeap);
+        stats.worst.largestBlock = min(stats.worst.largestBlock, sample.largestBlock);
+        stats.worst.stackFree = min(stats.worst.stackFree, sample.stackFree);
+    }
+    stats.last = sample;
+    stats.samples++;
+}
+
+uint32_t memMinFreeHeap() {
+    return ESP.getMinFreeHeap();
+}
+
+const MemStageStats& memStageStats(MemStage stage) {
+    return stageStats[stage];
+}
+
+const char* memStageName(MemStage stage) {
+    return stage < MEM_STAGE_COUNT ? stageNames[stage] : "unknown";
+}
+
+void exportMemStats(JsonObject out) {
+    MemSample now = memNow();
+    out["freeHeap"] = now.freeHeap;
+    out["largestBlock"] = now.largestBlock;
+    out["minFreeHeap"] = memMinFreeHeap();
+    out["heapSize"] = ESP.getHeapSize();
+    out["stackFree"] = now.stackFree;
+
+    JsonObject stages = out.createNestedObject("stages");
+    for (uint8_t i = 0; i < MEM_STAGE_COUNT; i++) {
+        const MemStageStats& stats = stageStats[i];
+        JsonObject stage = stages.createNestedObject(stageNames[i]);
+        stage["samples"] = stats.samples;
+        if (stats.samples == 0) continue;
+        stage["freeHeap"] = stats.last.freeHeap;
+        stage["worstFreeHeap"] = stats.worst.freeHeap;
+        stage["worstLargestBlock"] = stats.worst.largestBlock;
+        stage["worstStackFree"] = stats.worst.stackFree;
+    }
+}
@@ -0,0 +1,179 @@
+#include "metrics.h"
+#include "clock.h"
+#include "display.h"
+#include "memstats.h"
+#include "scheduler.h"
+#include <WiFi.h>
+#include <stdarg.h>
+
+extern Scheduler scheduler;
+extern DisplayManager display;
+
+MetricsWriter::MetricsWriter(WebServer& server) : server(server), used(0) {
+    server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+    server.send(200, "text/plain; version=0.0.4", "");
+}
+
+void MetricsWriter::append(const char* text, size_t len) {
+    while (len > 0) {
+        size_t room = sizeof(buffer) - used;
+        size_t n = len < room ? len : room;
+        memcpy(buffer + used, text, n);
+        used += n;
+        text += n;
+        len -= n;
+        if (used == sizeof(buffer)) flush();
+    }
+}
+
+void MetricsWriter::appendf(const char* format, ...) {
+    char line[160];
+    va_list args;
+    va_start(args, format);
+    int len = vsnprintf(line, sizeof(line), format, args);
+    va_end(args);
+    if (len < 0) return;
+    append(line, min((size_t)len, sizeof(line) - 1));
+}
+
+void MetricsWriter::flush() {
+    if (used == 0) return;
+    server.sendContent(buffer, used);
+    used = 0;
+}
+
+void MetricsWriter::family(const char* name, const char* type, const char* help) {
+    appendf("# HELP " METRICS_PREFIX "%s %s\n# TYPE " METRICS_PREFIX "%s %s\n", name, help, name, type);
+}
+
+void MetricsWriter::sample(const char* name, double value) {
+    appendf(METRICS_PREFIX "%s %.15g\n", name, value);
+}
+
+void MetricsWriter::sample(const char* name, const char* label, const char* labelValue, double value) {
+    appendf(METRICS_PREFIX "%s{%s=\"%s\"} %.15g\n", name, label, labelValue, value);
+}
+
+void MetricsWriter::finish() {
+    flush();
+    server.sendContent("");   // Empty chunk ends the response
+}
+
+// ============================================
+// Exported metrics
+// ============================================
+
+static const char* const schedulerStateNames[] = { "idle", "fetching", "cooldown", "retry_wait" };
+static const char* const statusClassNames[] = { "other", "1xx", "2xx", "3xx", "4xx", "5xx" };
+
+static void writeFetchMetrics(MetricsWriter& out) {
+    out.family("fetches_total", "counter", "Completed fetches per module");
+    for (uint8_t i = 0; i < MODULE_COUNT; i++) {
+        out.sample("fetches_total", "module", moduleNames[i], scheduler.getModuleStats((ModuleId)i).fetches);
+    }
+
+    out.family("fetch_failures_total", "counter", "Failed fetches per module");
+    for (uint8_t i = 0; i < MODULE_COUNT; i++) {
+        out.sample("fetch_failures_total", "module", moduleNames[i], scheduler.getModuleStats((ModuleId)i).failures);
+    }
+
+    out.family("fetch_duration_seconds", "summary", "Network time of fetches, connect to last byte");
+    for (uint8_t i = 0; i < MODULE_COUNT; i++) {
+        const ModuleFetchStats& stats = scheduler.getModuleStats((ModuleId)i);
+        if (stats.timed == 0) continue;   // Local modules never go over the network
+        out.sample("fetch_duration_seconds_sum", "module", moduleNames[i], stats.totalMs / 1000.0);
+        out.sample("fetch_duration_seconds_count", "module", moduleNames[i], stats.timed);
+    }
+
+    out.family("fetch_last_duration_seconds", "gauge", "Network time of the most recent fetch");
+    for (uint8_t i = 0; i < MODULE_COUNT; i++) {
+        const ModuleFetchStats& stats = scheduler.getModuleStats((ModuleId)i);
+        if (stats.timed == 0) continue;
+        out.sample("fetch_last_duration_seconds", "module", moduleNames[i], stats.lastMs / 1000.0);
+    }
+}
+
+static void writeHttpMetrics(MetricsWriter& out) {
+    const FetchStats& stats = scheduler.getFetchStats();
+
+    out.family("http_responses_total", "counter", "Complete upstream responses by status class");
+    for (uint8_t i = 0; i < 6; i++) {
+        if (i == 0 && stats.statusClasses[0] == 0) continue;
+        out.sample("http_responses_total", "class", statusClassNames[i], stats.statusClasses[i]);
+    }
+
+    out.family("http_failures_total", "counter", "Upstream requests lost to timeouts, connection or protocol errors");
+    out.sample("http_failures_total", stats.failures);
+    out.family("http_requests_total", "counter", "Upstream requests sent");
+    out.sample("http_requests_total", stats.requests);
+    out.family("tls_handshakes_total", "counter", "New TCP and TLS connections");
+    out.sample("tls_handshakes_total", stats.handshakes);
+    out.family("http_sent_bytes_total", "counter", "HTTP bytes sent, TLS overhead excluded");
+    out.sample("http_sent_bytes_total", stats.bytesSent);
+    out.family("http_received_bytes_total", "counter", "HTTP bytes received, headers included");
+    out.sample("http_received_bytes_total", stats.bytesReceived);
+}
+
+static void writeSchedulerMetrics(MetricsWriter& out) {
+    const SchedulerContext& context = scheduler.getContext();
+    uint64_t now = uptimeSeconds();
+
+    out.family("scheduler_state", "gauge", "Current scheduler state");
+    for (uint8_t i = 0; i < sizeof(schedulerStateNames) / sizeof(schedulerStateNames[0]); i++) {
+        out.sample("scheduler_state", "state", schedulerStateNames[i], context.state == i ? 1 : 0);
+    }
+
+    out.family("background_refreshes_total", "counter", "Fetches for modules other than the active one");
+    out.sample("background_refreshes_total", scheduler.getBackgroundCount());
+
+    out.family("backoff_retries", "gauge", "Consecutive failures per module");
+    for (uint8_t i = 0; i < MODULE_COUNT; i++) {
+        out.sample("backoff_retries", "module", moduleNames[i], scheduler.getBackoff((ModuleId)i).retryCount);
+    }
+
+    out.family("backoff_remaining_seconds", "gauge", "Time until a backed-off module may fetch again");
+    for (uint8_t i = 0; i < MODULE_COUNT; i++) {
+        uint64_t retryAt = scheduler.getBackoff((ModuleId)i).retryAt;
+        out.sample("backoff_remaining_seconds", "module", moduleNames[i], (double)(retryAt > now ? retryAt - now : 0));
+    }
+}
+
+static void writeDeviceMetrics(MetricsWriter& out) {
+    out.family("uptime_seconds", "gauge", "Time since boot");
+    out.sample("uptime_seconds", uptimeMillis() / 1000.0);
+
+    MemSample mem = memNow();
+    out.family("heap_free_bytes", "gauge", "Free heap");
+    out.sample("heap_free_bytes", mem.freeHeap);
+    out.family("heap_min_free_bytes", "gauge", "Lowest free heap since boot");
+    out.sample("heap_min_free_bytes", memMinFreeHeap());
+    out.family("heap_largest_block_bytes", "gauge", "Largest allocatable block");
+    out.sample("heap_largest_block_bytes", mem.largestBlock);
+    out.family("heap_size_bytes", "gauge", "Total heap");
+    out.sample("heap_size_bytes", ESP.getHeapSize());
+    out.family("loop_stack_free_bytes", "gauge", "Loop task stack never used since boot");
+    out.sample("loop_stack_free_bytes", mem.stackFree);
+
+    const DisplayStats& frames = display.getStats();
+    out.family("display_frames_total", "counter", "Frames sent to the display");
+    out.sample("display_frames_total", frames.frames);
+    out.family("display_frames_skipped_total", "counter", "Module frames skipped because nothing visible changed");
+    out.sample("display_frames_skipped_total", frames.skipped);
+    out.family("display_tiles_sent_total", "counter", "8-byte display tiles transferred");
+    out.sample("display_tiles_sent_total", frames.tilesSent);
+
+    bool connected = WiFi.isConnected();
+    out.family("wifi_connected", "gauge", "1 when associated with the access point");
+    out.sample("wifi_connected", connected ? 1 : 0);
+    if (connected) {
+        out.family("wifi_rssi_dbm", "gauge", "Received signal strength");
+        out.sample("wifi_rssi_dbm", WiFi.RSSI());
+    }
+}
+
+void writeMetrics(MetricsWriter& out) {
+    writeFetchMetrics(out);
+    writeHttpMetrics(out);
+    writeSchedulerMetrics(out);
+    writeDeviceMetrics(out);
+}
@@ -1,11 +1,7 @@
 #include "module_interface.h"
 #include "config.h"
-#include "network.h"
 #include <ArduinoJson.h>
 
-// External network manager (will be initialized in main)
-extern NetworkManager network;
-
 class BitcoinModule : public ModuleInterface {
 public:
     BitcoinModule() {
@@ -15,48 +11,50 @@ public:
         minRefreshInterval = 60;       // 1 minute
     }
 
-    bool fetch(String& errorMsg) override {
-        // Get configured crypto ID (default to bitcoin)
-        JsonObject moduleData = config["modules"]["bitcoin"];
-        String cryptoId = moduleData["cryptoId"] | "bitcoin";
-
-        // Build URL with configured crypto
-        String url = "https://api.coingecko.com/api/v3/simple/price?ids=" + cryptoId +
-                     "&vs_currencies=usd&include_24hr_change=true";
+    // All crypto modules share one /simple/price request (see Scheduler)
+    const char* batchKey() override { return "coingecko"; }
 
-        String response;
-        if (!network.httpGet(url.c_str(), response, errorMsg)) {
-            return false;
-        }
+    String batchParam() override {
+        // Get configured crypto ID (default to bitcoin)
+        return config["modules"]["bitcoin"]["cryptoId"] | "bitcoin";
+    }
 
-        return parseResponse(response, errorMsg, cryptoId);
+    bool buildBatchRequest(const String& cryptoIds, String& url) override {
+        url = "https://api.coingecko.com/api/v3/simple/price?ids=" + cryptoIds +
+              "&vs_currencies=usd&include_24hr_change=true";
+        return true;
     }
 
-    bool parseResponse(String payload, String& errorMsg, String cryptoId) {
-        StaticJsonDocument<512> doc;
-        DeserializationError error = deserializeJson(doc, payload);
+    bool buildRequest(String& url) override {
+        return buildBatchRequest(batchParam(), url);
+    }
 
-        if (error) {
-            errorMsg = "JSON parse error: " + String(error.c_str());
-            return false;
-        }
+    void responseFilter(JsonDocument& filter) override {
+        // Keep only this crypto's fields; the response may also carry
+        // prices for other batched crypto modules
+        String cryptoId = batchParam();
+        filter[cryptoId]["usd"] = true;
+        filter[cryptoId]["usd_24h_change"] = true;
+    }
 
-        if (!doc.containsKey(cryptoId)) {
+    bool readResponse(JsonVariantConst response, String& errorMsg) override {
+        JsonVariantConst prices = response[batchParam()];
+        if (prices.isNull()) {
             errorMsg = "Invalid response structure";
             return false;
         }
 
-        float price = doc[cryptoId]["usd"];
-        float change = doc[cryptoId]["usd_24h_change"];
+        float price = prices["usd"];
+        float change = prices["usd_24h_change"];
 
-        // Update cache (preserve existing fields like cryptoId/cryptoSymbol/cryptoName)
-        JsonObject data = config["modules"]["bitcoin"];
-        data["value"] = price;
-        data["change24h"] = change;
-        data["lastUpdate"] = millis() / 1000;
-        data["lastSuccess"] = true;
+        // Update cache
+        ModuleCacheEntry& data = moduleCache[SLOT_BITCOIN];
+        data.value = price;
+        data.change = change;
+        stampModuleCache(data);
+        data.lastSuccess = true;
 
-        String cryptoName = data["cryptoName"] | "Bitcoin";
+        String cryptoName = config["modules"]["bitcoin"]["cryptoName"] | "Bitcoin";
         Serial.print(cryptoName);
         Serial.print(" price: $");
         Serial.print(price, 2);
@@ -67,10 +65,43 @@ public:
         return true;
     }
 
+    bool applyConfig(JsonObject changes) override {
+        JsonObject cfg = moduleConfig(MODULE_BITCOIN);
+        bool cryptoChanged = false;
+        if (changes.containsKey("cryptoId")) {
+            String newId = changes["cryptoId"].as<String>();
+            String oldId = cfg["cryptoId"] | "bitcoin";
+            if (newId != oldId) {
+                cryptoChanged = true;
+            }
+            cfg["cryptoId"] = newId;
+            Serial.print("Bitcoin cryptoId updated to: ");
+            Serial.println(newId);
+        }
+        if (changes.containsKey("cryptoSymbol")) {
+            String symbol = changes["cryptoSymbol"].as<String>();
+            cfg["cryptoSymbol"] = symbol;
+            Serial.print("Bitcoin cryptoSymbol updated to: ");
+            Serial.println(symbol);
+        }
+        if (changes.containsKey("cryptoName")) {
+            String name = changes["cryptoName"].as<String>();
+            cfg["cryptoName"] = name;
+            Serial.print("Bitcoin cryptoName updated to: ");
+            Serial.println(name);
+        }
+        // Clear cached data if crypto changed
+        if (cryptoChanged) {
+            clearModuleCache(SLOT_BITCOIN);
+            Serial.println("Bitcoin crypto changed - cleared cache");
+        }
+        return changes.containsKey("cryptoId");
+    }
+
     String formatDisplay() override {
-        JsonObject data = config["modules"]["bitcoin"];
-        float price = data["value"] | 0.0;
-        float change = data["change24h"] | 0.0;
+        const ModuleCacheEntry& data = moduleCache[SLOT_BITCOIN];
+        float price = data.value;
+        float change = data.change;
 
         char buffer[64];
         snprintf(buffer, sizeof(buffer), "$%.2f | %+.1f%%", price, change);
@@ -15,25 +15,36 @@ public:
         // Custom module doesn't fetch from external API
         // Value is set directly by user via config portal
 
-        JsonObject data = config["modules"]["custom"];
-        data["lastUpdate"] = millis() / 1000;
-        data["lastSuccess"] = true;
+        ModuleCacheEntry& data = moduleCache[SLOT_CUSTOM];
+        stampModuleCache(data);
+        data.lastSuccess = true;
 
         Serial.println("Custom module: No fetch needed (manual entry)");
         return true;
     }
 
+    bool applyConfig(JsonObject changes) override {
+        JsonObject cfg = moduleConfig(MODULE_CUSTOM);
+        if (changes.containsKey("label")) {
+            cfg["label"] = changes["label"].as<String>();
+        }
+        if (changes.containsKey("value")) {
+            cfg["value"] = changes["value"].as<float>();
+        }
+        if (changes.containsKey("unit")) {
+            cfg["unit"] = changes["unit"].as<String>();
+        }
+        return false;  // Manual value, nothing to fetch
+    }
+
     String formatDisplay() override {
-        JsonObject data = config["modules"]["custom"];
-        float value = data["value"] | 0.0;
-        String label = data["label"] | "Custom";
-        String unit = data["unit"] | "";
+        const ModuleCacheEntry& data = moduleCache[SLOT_CUSTOM];
 
         char buffer[64];
-        if (unit.length() > 0) {
-            snprintf(buffer, sizeof(buffer), "%.2f %s", value, unit.c_str());
+        if (data.unit[0] != '\0') {
+            snprintf(buffer, sizeof(buffer), "%.2f %s", data.value, data.unit);
         } else {
-            snprintf(buffer, sizeof(buffer), "%.2f", value);
+            snprintf(buffer, sizeof(buffer), "%.2f", data.value);
         }
         return String(buffer);
     }
@@ -18,12 +18,30 @@ public:
     virtual ~ModuleInterface() {}
 
     // Core functions that all modules must implement
-    virtual bool fetch(String& errorMsg) = 0;
     virtual String formatDisplay() = 0;
 
-    // Optional configuration functions
-    virtual bool parseConfig(JsonObject cfg) { return true; }
-    virtual JsonObject getConfig() { return JsonObject(); }
+    // Data acquisition. Network modules return their request URL from
+    // buildRequest(); the scheduler parses the body once, as it arrives,
+    // keeping only the fields the modules add in responseFilter(), and
+    // hands the document to readResponse(). It is reused by the next request.
+    // Modules without a remote source override fetch().
+    virtual bool buildRequest(String& url) { return false; }
+    virtual void responseFilter(JsonDocument& filter) {}
+    virtual bool readResponse(JsonVariantConst response, String& errorMsg) { return false; }
+    virtual bool fetch(String& errorMsg) { errorMsg = "No data source"; return false; }
+
+    // Request batching. Modules with the same batchKey() are fetched with one
+    // request: the scheduler joins their batchParam()s with commas, asks the
+    // module being fetched to build the URL, and hands the response to every
+    // member's readResponse().
+    virtual const char* batchKey() { return nullptr; }
+    virtual String batchParam() { return String(); }
+    virtual bool buildBatchRequest(const String& params, String& url) { return false; }
+
+    // Settings posted from the web UI. Copies the keys the module knows from
+    // changes into its config section; returns true when the cached reading
+    // no longer applies and the module should be fetched again.
+    virtual bool applyConfig(JsonObject changes) { return false; }
 };
 
 #endif // MODULE_INTERFACE_H
@@ -16,39 +16,23 @@ public:
 
     bool fetch(String& errorMsg) override {
         // Settings module doesn't fetch data from network
-        // Instead, it generates a new security code
+        // Instead, it generates a new security code. The code lives in the
+        // security manager only; it is runtime state, not a setting.
 
         uint32_t code = security.generateNewCode();
 
-        // Store code in config for display
-        JsonObject data = config["modules"]["settings"];
-        data["securityCode"] = code;
-        data["codeTimeRemaining"] = security.getCodeTimeRemaining();
-        data["lastUpdate"] = millis() / 1000;
-        data["lastSuccess"] = true;
-
         Serial.print("Settings module: New security code generated: ");
         Serial.println(code);
 
         return true;
     }
 
-    bool parseResponse(String payload, String& errorMsg) {
-        // Not applicable for settings module
-        return true;
-    }
-
     String formatDisplay() override {
-        JsonObject data = config["modules"]["settings"];
-        uint32_t code = data["securityCode"] | 0;
+        uint32_t code = security.getCurrentCode();
 
         // If code is 0, generate one immediately (defensive coding)
         if (code == 0) {
             code = security.generateNewCode();
-            data["securityCode"] = code;
-            data["codeTimeRemaining"] = security.getCodeTimeRemaining();
-            data["lastUpdate"] = millis() / 1000;
-            data["lastSuccess"] = true;
             Serial.println("Settings: Generated code on-demand in formatDisplay()");
         }
 
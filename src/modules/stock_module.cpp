@@ -1,10 +1,7 @@
 #include "module_interface.h"
 #include "config.h"
-#include "network.h"
 #include <ArduinoJson.h>
 
-extern NetworkManager network;
-
 class StockModule : public ModuleInterface {
 public:
     StockModule() {
@@ -14,54 +11,46 @@ public:
         minRefreshInterval = 60;       // 1 minute
     }
 
-    bool fetch(String& errorMsg) override {
+    bool buildRequest(String& url) override {
         // Get ticker from config
         JsonObject stockData = config["modules"]["stock"];
         String ticker = stockData["ticker"] | "AAPL";
 
-        String url = "https://query1.finance.yahoo.com/v7/finance/quote?symbols=" + ticker;
-
-        String response;
-        if (!network.httpGet(url.c_str(), response, errorMsg)) {
-            return false;
-        }
-
-        return parseResponse(response, errorMsg);
+        url = "https://query1.finance.yahoo.com/v7/finance/quote?symbols=" + ticker;
+        return true;
     }
 
-    bool parseResponse(String payload, String& errorMsg) {
-        DynamicJsonDocument doc(2048);
-        DeserializationError error = deserializeJson(doc, payload);
-
-        if (error) {
-            errorMsg = "JSON parse error: " + String(error.c_str());
-            return false;
-        }
+    void responseFilter(JsonDocument& filter) override {
+        // Keep only the fields this module reads; the full quote has ~80
+        JsonObject quoteFilter = filter["quoteResponse"]["result"].createNestedObject();
+        quoteFilter["regularMarketPrice"] = true;
+        quoteFilter["regularMarketChangePercent"] = true;
+        quoteFilter["symbol"] = true;
+    }
 
-        if (!doc.containsKey("quoteResponse") || !doc["quoteResponse"].containsKey("result")) {
+    bool readResponse(JsonVariantConst response, String& errorMsg) override {
+        JsonArrayConst results = response["quoteResponse"]["result"];
+        if (results.isNull()) {
             errorMsg = "Invalid response structure";
             return false;
         }
-
-        JsonArray results = doc["quoteResponse"]["result"];
         if (results.size() == 0) {
             errorMsg = "Invalid ticker symbol";
             return false;
         }
 
-        JsonObject quote = results[0];
+        JsonObjectConst quote = results[0];
         float price = quote["regularMarketPrice"] | 0.0;
         float change = quote["regularMarketChangePercent"] | 0.0;
-        String symbol = quote["symbol"] | "N/A";
 
-        // Update cache (preserve existing fields like ticker and name)
-        JsonObject data = config["modules"]["stock"];
-        data["value"] = price;
-        data["change"] = change;
-        data["lastUpdate"] = millis() / 1000;
-        data["lastSuccess"] = true;
+        // Update cache
+        ModuleCacheEntry& data = moduleCache[SLOT_STOCK];
+        data.value = price;
+        data.change = change;
+        stampModuleCache(data);
+        data.lastSuccess = true;
 
-        Serial.print(symbol);
+        Serial.print(quote["symbol"] | "N/A");
         Serial.print(" price: $");
         Serial.print(price, 2);
         Serial.print(" (");
@@ -71,14 +60,25 @@ public:
         return true;
     }
 
+    bool applyConfig(JsonObject changes) override {
+        JsonObject cfg = moduleConfig(MODULE_STOCK);
+        bool tickerChanged = changes.containsKey("ticker");
+        if (tickerChanged) {
+            cfg["ticker"] = changes["ticker"].as<String>();
+            // Clear cached stock data to force fresh fetch
+            clearModuleCache(SLOT_STOCK);
+        }
+        if (changes.containsKey("name")) {
+            cfg["name"] = changes["name"].as<String>();
+        }
+        return tickerChanged;
+    }
+
     String formatDisplay() override {
-        JsonObject data = config["modules"]["stock"];
-        float price = data["value"] | 0.0;
-        float change = data["change"] | 0.0;
-        String ticker = data["ticker"] | "N/A";
+        const ModuleCacheEntry& data = moduleCache[SLOT_STOCK];
 
         char buffer[64];
-        snprintf(buffer, sizeof(buffer), "%s: $%.2f | %+.1f%%", ticker.c_str(), price, change);
+        snprintf(buffer, sizeof(buffer), "%s: $%.2f | %+.1f%%", data.label, data.value, data.change);
         return String(buffer);
     }
 };
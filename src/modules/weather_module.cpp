@@ -1,10 +1,7 @@
 #include "module_interface.h"
 #include "config.h"
-#include "network.h"
 #include <ArduinoJson.h>
 
-extern NetworkManager network;
-
 class WeatherModule : public ModuleInterface {
 public:
     WeatherModule() {
@@ -14,7 +11,7 @@ public:
         minRefreshInterval = 300;      // 5 minutes
     }
 
-    bool fetch(String& errorMsg) override {
+    bool buildRequest(String& url) override {
         // Get location from config (format: "lat,lon" or uses defaults)
         JsonObject weatherData = config["modules"]["weather"];
         String location = weatherData["location"] | "37.7749,-122.4194";
@@ -29,41 +26,33 @@ public:
             lon = location.substring(commaIndex + 1).toFloat();
         }
 
-        String url = "https://api.open-meteo.com/v1/forecast?latitude=" + String(lat, 4) +
-                     "&longitude=" + String(lon, 4) + "&current_weather=true";
-
-        String response;
-        if (!network.httpGet(url.c_str(), response, errorMsg)) {
-            return false;
-        }
-
-        return parseResponse(response, errorMsg);
+        url = "https://api.open-meteo.com/v1/forecast?latitude=" + String(lat, 4) +
+              "&longitude=" + String(lon, 4) + "&current_weather=true";
+        return true;
     }
 
-    bool parseResponse(String payload, String& errorMsg) {
-        StaticJsonDocument<1024> doc;
-        DeserializationError error = deserializeJson(doc, payload);
-
-        if (error) {
-            errorMsg = "JSON parse error: " + String(error.c_str());
-            return false;
-        }
+    void responseFilter(JsonDocument& filter) override {
+        // Keep only the fields this module reads
+        filter["current_weather"]["temperature"] = true;
+        filter["current_weather"]["weathercode"] = true;
+    }
 
-        if (!doc.containsKey("current_weather")) {
+    bool readResponse(JsonVariantConst response, String& errorMsg) override {
+        JsonObjectConst currentWeather = response["current_weather"];
+        if (currentWeather.isNull()) {
             errorMsg = "Invalid response structure";
             return false;
         }
 
-        JsonObject currentWeather = doc["current_weather"];
         float temp = currentWeather["temperature"];
         int weatherCode = currentWeather["weathercode"];
 
-        // Update cache (preserve existing fields like location, latitude, longitude)
-        JsonObject data = config["modules"]["weather"];
-        data["temperature"] = temp;
-        data["condition"] = getWeatherCondition(weatherCode);
-        data["lastUpdate"] = millis() / 1000;
-        data["lastSuccess"] = true;
+        // Update cache
+        ModuleCacheEntry& data = moduleCache[SLOT_WEATHER];
+        data.value = temp;
+        strlcpy(data.detail, getWeatherCondition(weatherCode), sizeof(data.detail));
+        stampModuleCache(data);
+        data.lastSuccess = true;
 
         Serial.print("Weather: ");
         Serial.print(temp, 1);
@@ -82,14 +71,50 @@ public:
         return "Unknown";
     }
 
+    bool applyConfig(JsonObject changes) override {
+        JsonObject cfg = moduleConfig(MODULE_WEATHER);
+        bool locationChanged = changes.containsKey("location");
+        if (locationChanged) {
+            String location = changes["location"].as<String>();
+            // URL decode the location string
+            String decoded = "";
+            for (size_t i = 0; i < location.length(); i++) {
+                char c = location[i];
+                if (c == '%' && i + 2 < location.length()) {
+                    char hex[3] = {location[i+1], location[i+2], 0};
+                    decoded += (char)strtol(hex, NULL, 16);
+                    i += 2;
+                } else if (c == '+') {
+                    decoded += ' ';
+                } else {
+                    decoded += c;
+                }
+            }
+            cfg["location"] = decoded;
+            // Clear cached weather data to force fresh fetch
+            clearModuleCache(SLOT_WEATHER);
+            Serial.print("Weather location updated to: ");
+            Serial.println(decoded);
+            Serial.print("Location bytes: ");
+            for (size_t i = 0; i < decoded.length(); i++) {
+                Serial.printf("%02X ", (uint8_t)decoded[i]);
+            }
+            Serial.println();
+        }
+        if (changes.containsKey("latitude")) {
+            cfg["latitude"] = changes["latitude"].as<float>();
+        }
+        if (changes.containsKey("longitude")) {
+            cfg["longitude"] = changes["longitude"].as<float>();
+        }
+        return locationChanged;
+    }
+
     String formatDisplay() override {
-        JsonObject data = config["modules"]["weather"];
-        float temp = data["temperature"] | 0.0;
-        String condition = data["condition"] | "Unknown";
-        String location = data["location"] | "Unknown";
+        const ModuleCacheEntry& data = moduleCache[SLOT_WEATHER];
 
         char buffer[64];
-        snprintf(buffer, sizeof(buffer), "%.1f°C | %s | %s", temp, condition.c_str(), location.c_str());
+        snprintf(buffer, sizeof(buffer), "%.1f°C | %s | %s", data.value, data.detail, data.label);
         return String(buffer);
     }
 };
@@ -2,6 +2,9 @@
 #include "config.h"
 #include "security.h"
 #include "scheduler.h"
+#include "memstats.h"
+#include "metrics.h"
+#include "modules/module_interface.h"
 #include <ESPmDNS.h>
 #include <LittleFS.h>
 
@@ -276,7 +279,7 @@ bool NetworkManager::connectWiFi(const char* ssid, const char* password, uint16_
     WiFi.mode(WIFI_STA);
     WiFi.begin(ssid, password);
 
-    unsigned long startTime = millis();
+    uint32_t startTime = millis();
     while (WiFi.status() != WL_CONNECTED && (millis() - startTime) < timeout) {
         delay(500);
         Serial.print(".");
@@ -338,7 +341,7 @@ void NetworkManager::startConfigAP() {
 
     cachedScanResults = "[]";
     scanInProgress = false;
-    lastScanTime = millis();
+    lastScanTime = uptimeMillis();
     clientWasConnected = false;
 
     Serial.println();
@@ -422,7 +425,7 @@ bool NetworkManager::isConnected() {
 void NetworkManager::reconnect() {
     if (isAPMode) return;
 
-    unsigned long now = millis();
+    uint64_t now = uptimeMillis();
     if (now - lastReconnectAttempt < 30000) return;
 
     lastReconnectAttempt = now;
@@ -447,34 +450,6 @@ void NetworkManager::handleClient() {
     }
 }
 
-bool NetworkManager::httpGet(const char* url, String& response, String& errorMsg) {
-    WiFiClientSecure* client = new WiFiClientSecure;
-    if (!client) {
-        errorMsg = "Out of memory";
-        return false;
-    }
-
-    client->setInsecure();
-
-    HTTPClient https;
-    https.begin(*client, url);
-    https.setTimeout(15000);
-
-    int httpCode = https.GET();
-
-    if (httpCode == HTTP_CODE_OK) {
-        response = https.getString();
-        https.end();
-        delete client;
-        return true;
-    } else {
-        errorMsg = "HTTP " + String(httpCode);
-        https.end();
-        delete client;
-        return false;
-    }
-}
-
 void NetworkManager::startWiFiScan() {
     Serial.println("Starting WiFi scan...");
 
@@ -490,7 +465,7 @@ void NetworkManager::startWiFiScan() {
 
     if (result == WIFI_SCAN_RUNNING) {
         scanInProgress = true;
-        lastScanTime = millis();
+        lastScanTime = uptimeMillis();
         Serial.println("Scan started");
     } else {
         Serial.println("Scan failed to start");
@@ -499,9 +474,9 @@ void NetworkManager::startWiFiScan() {
 
 void NetworkManager::updateScanResults() {
     if (!scanInProgress) {
-        unsigned long timeSinceLastScan = millis() - lastScanTime;
+        uint64_t now = uptimeMillis();
         // Wait 10 seconds after boot for WiFi to stabilize, then rescan every 30 seconds
-        if ((lastScanTime < 10000 && millis() > 10000) || timeSinceLastScan > 30000) {
+        if ((lastScanTime < 10000 && now > 10000) || now - lastScanTime > 30000) {
             startWiFiScan();
         }
         return;
@@ -510,7 +485,7 @@ void NetworkManager::updateScanResults() {
     int n = WiFi.scanComplete();
 
     if (n == WIFI_SCAN_RUNNING) {
-        unsigned long scanDuration = millis() - lastScanTime;
+        uint64_t scanDuration = uptimeMillis() - lastScanTime;
         if (scanDuration > 15000) {
             Serial.println("Scan timeout");
             WiFi.scanDelete();
@@ -545,7 +520,7 @@ void NetworkManager::updateScanResults() {
 
         cachedScanResults = json;
         scanInProgress = false;
-        lastScanTime = millis();
+        lastScanTime = uptimeMillis();
 
         Serial.println("Scan complete");
         WiFi.scanDelete();
@@ -627,6 +602,18 @@ void NetworkManager::setupSettingsServer() {
         handleStockSearch();
     });
 
+    // Heap and stack telemetry (no auth required) - see memstats.h
+    server->on("/api/mem", HTTP_GET, [this]() {
+        handleMemStats();
+    });
+
+    // Prometheus scrape target (no auth required) - see metrics.h
+    server->on("/metrics", HTTP_GET, [this]() {
+        MetricsWriter out(*server);
+        writeMetrics(out);
+        out.finish();
+    });
+
     // Debug endpoint (no auth required) - shows crypto module config only
     server->on("/debug", [this]() {
         String html = "<!DOCTYPE html><html><head><title>Debug Config</title>";
@@ -644,9 +631,11 @@ void NetworkManager::setupSettingsServer() {
         html += "<td>cryptoId</td><td>" + String(bitcoin["cryptoId"] | "NOT SET") + "</td></tr>";
         html += "<tr><td>cryptoSymbol</td><td>" + String(bitcoin["cryptoSymbol"] | "NOT SET") + "</td></tr>";
         html += "<tr><td>cryptoName</td><td>" + String(bitcoin["cryptoName"] | "NOT SET") + "</td></tr>";
-        html += "<tr><td>value</td><td>$" + String(bitcoin["value"] | 0.0, 2) + "</td></tr>";
-        html += "<tr><td>lastUpdate</td><td>" + String(bitcoin["lastUpdate"] | 0) + "</td></tr>";
-        html += "<tr><td>lastSuccess</td><td>" + String(bitcoin["lastSuccess"] | false ? "true" : "false") + "</td></tr>";
+        const ModuleCacheEntry& bitcoinCache = moduleCache[SLOT_BITCOIN];
+        html += "<tr><td>value</td><td>$" + String(bitcoinCache.value, 2) + "</td></tr>";
+        char timeAgo[TIME_AGO_LEN];
+        html += "<tr><td>lastUpdate</td><td>" + String(formatTimeAgo(bitcoinCache.lastUpdate, timeAgo, sizeof(timeAgo))) + "</td></tr>";
+        html += "<tr><td>lastSuccess</td><td>" + String(bitcoinCache.lastSuccess ? "true" : "false") + "</td></tr>";
 
         // Ethereum module
         JsonObject ethereum = config["modules"]["ethereum"];
@@ -654,9 +643,10 @@ void NetworkManager::setupSettingsServer() {
         html += "<td>cryptoId</td><td>" + String(ethereum["cryptoId"] | "NOT SET") + "</td></tr>";
         html += "<tr><td>cryptoSymbol</td><td>" + String(ethereum["cryptoSymbol"] | "NOT SET") + "</td></tr>";
         html += "<tr><td>cryptoName</td><td>" + String(ethereum["cryptoName"] | "NOT SET") + "</td></tr>";
-        html += "<tr><td>value</td><td>$" + String(ethereum["value"] | 0.0, 2) + "</td></tr>";
-        html += "<tr><td>lastUpdate</td><td>" + String(ethereum["lastUpdate"] | 0) + "</td></tr>";
-        html += "<tr><td>lastSuccess</td><td>" + String(ethereum["lastSuccess"] | false ? "true" : "false") + "</td></tr>";
+        const ModuleCacheEntry& ethereumCache = moduleCache[SLOT_ETHEREUM];
+        html += "<tr><td>value</td><td>$" + String(ethereumCache.value, 2) + "</td></tr>";
+        html += "<tr><td>lastUpdate</td><td>" + String(formatTimeAgo(ethereumCache.lastUpdate, timeAgo, sizeof(timeAgo))) + "</td></tr>";
+        html += "<tr><td>lastSuccess</td><td>" + String(ethereumCache.lastSuccess ? "true" : "false") + "</td></tr>";
 
         html += "</table>";
 
@@ -774,134 +764,14 @@ void NetworkManager::handleUpdateConfig() {
         }
     }
 
+    // Each module applies its own settings and says whether to refetch
+    bool refetch[MODULE_COUNT] = {};
     if (doc.containsKey("modules")) {
         JsonObject modules = doc["modules"];
-
-        // Update bitcoin crypto config
-        if (modules.containsKey("bitcoin")) {
-            bool cryptoChanged = false;
-            if (modules["bitcoin"].containsKey("cryptoId")) {
-                String newId = modules["bitcoin"]["cryptoId"].as<String>();
-                String oldId = config["modules"]["bitcoin"]["cryptoId"] | "bitcoin";
-                if (newId != oldId) {
-                    cryptoChanged = true;
-                }
-                config["modules"]["bitcoin"]["cryptoId"] = newId;
-                Serial.print("Bitcoin cryptoId updated to: ");
-                Serial.println(newId);
-            }
-            if (modules["bitcoin"].containsKey("cryptoSymbol")) {
-                String symbol = modules["bitcoin"]["cryptoSymbol"].as<String>();
-                config["modules"]["bitcoin"]["cryptoSymbol"] = symbol;
-                Serial.print("Bitcoin cryptoSymbol updated to: ");
-                Serial.println(symbol);
-            }
-            if (modules["bitcoin"].containsKey("cryptoName")) {
-                String name = modules["bitcoin"]["cryptoName"].as<String>();
-                config["modules"]["bitcoin"]["cryptoName"] = name;
-                Serial.print("Bitcoin cryptoName updated to: ");
-                Serial.println(name);
-            }
-            // Clear cached data if crypto changed
-            if (cryptoChanged) {
-                config["modules"]["bitcoin"]["value"] = 0.0;
-                config["modules"]["bitcoin"]["change24h"] = 0.0;
-                config["modules"]["bitcoin"]["lastUpdate"] = 0;
-                Serial.println("Bitcoin crypto changed - cleared cache");
-            }
-        }
-
-        // Update ethereum crypto config
-        if (modules.containsKey("ethereum")) {
-            bool cryptoChanged = false;
-            if (modules["ethereum"].containsKey("cryptoId")) {
-                String newId = modules["ethereum"]["cryptoId"].as<String>();
-                String oldId = config["modules"]["ethereum"]["cryptoId"] | "ethereum";
-                if (newId != oldId) {
-                    cryptoChanged = true;
-                }
-                config["modules"]["ethereum"]["cryptoId"] = newId;
-            }
-            if (modules["ethereum"].containsKey("cryptoSymbol")) {
-                config["modules"]["ethereum"]["cryptoSymbol"] = modules["ethereum"]["cryptoSymbol"].as<String>();
-            }
-            if (modules["ethereum"].containsKey("cryptoName")) {
-                config["modules"]["ethereum"]["cryptoName"] = modules["ethereum"]["cryptoName"].as<String>();
-            }
-            // Clear cached data if crypto changed
-            if (cryptoChanged) {
-                config["modules"]["ethereum"]["value"] = 0.0;
-                config["modules"]["ethereum"]["change24h"] = 0.0;
-                config["modules"]["ethereum"]["lastUpdate"] = 0;
-                Serial.println("Ethereum crypto changed - cleared cache");
-            }
-        }
-
-        // Update stock config
-        if (modules.containsKey("stock")) {
-            if (modules["stock"].containsKey("ticker")) {
-                config["modules"]["stock"]["ticker"] = modules["stock"]["ticker"].as<String>();
-                // Clear cached stock data to force fresh fetch
-                config["modules"]["stock"]["value"] = 0.0;
-                config["modules"]["stock"]["change"] = 0.0;
-                config["modules"]["stock"]["lastUpdate"] = 0;
-                config["modules"]["stock"]["lastSuccess"] = false;
-            }
-            if (modules["stock"].containsKey("name")) {
-                config["modules"]["stock"]["name"] = modules["stock"]["name"].as<String>();
-            }
-        }
-
-        // Update weather config
-        if (modules.containsKey("weather")) {
-            if (modules["weather"].containsKey("location")) {
-                String location = modules["weather"]["location"].as<String>();
-                // URL decode the location string
-                String decoded = "";
-                for (size_t i = 0; i < location.length(); i++) {
-                    char c = location[i];
-                    if (c == '%' && i + 2 < location.length()) {
-                        char hex[3] = {location[i+1], location[i+2], 0};
-                        decoded += (char)strtol(hex, NULL, 16);
-                        i += 2;
-                    } else if (c == '+') {
-                        decoded += ' ';
-                    } else {
-                        decoded += c;
-                    }
-                }
-                config["modules"]["weather"]["location"] = decoded;
-                // Clear cached weather data to force fresh fetch
-                config["modules"]["weather"]["temperature"] = 0;
-                config["modules"]["weather"]["condition"] = "Unknown";
-                config["modules"]["weather"]["lastUpdate"] = 0;
-                config["modules"]["weather"]["lastSuccess"] = false;
-                Serial.print("Weather location updated to: ");
-                Serial.println(decoded);
-                Serial.print("Location bytes: ");
-                for (size_t i = 0; i < decoded.length(); i++) {
-                    Serial.printf("%02X ", (uint8_t)decoded[i]);
-                }
-                Serial.println();
-            }
-            if (modules["weather"].containsKey("latitude")) {
-                config["modules"]["weather"]["latitude"] = modules["weather"]["latitude"].as<float>();
-            }
-            if (modules["weather"].containsKey("longitude")) {
-                config["modules"]["weather"]["longitude"] = modules["weather"]["longitude"].as<float>();
-            }
-        }
-
-        // Update custom config
-        if (modules.containsKey("custom")) {
-            if (modules["custom"].containsKey("label")) {
-                config["modules"]["custom"]["label"] = modules["custom"]["label"].as<String>();
-            }
-            if (modules["custom"].containsKey("value")) {
-                config["modules"]["custom"]["value"] = modules["custom"]["value"].as<float>();
-            }
-            if (modules["custom"].containsKey("unit")) {
-                config["modules"]["custom"]["unit"] = modules["custom"]["unit"].as<String>();
+        for (uint8_t i = 0; i < MODULE_COUNT; i++) {
+            JsonObject changes = modules[moduleNames[i]];
+            if (!changes.isNull()) {
+                refetch[i] = moduleTable[i]->applyConfig(changes);
             }
         }
     }
@@ -914,23 +784,12 @@ void NetworkManager::handleUpdateConfig() {
     loadConfiguration();
 
     // Trigger forced fetches for modules that changed
-    if (doc.containsKey("modules")) {
-        JsonObject modules = doc["modules"];
-        if (modules.containsKey("bitcoin") && modules["bitcoin"].containsKey("cryptoId")) {
-            Serial.println("Requesting forced fetch for bitcoin module");
-            scheduler.requestFetch("bitcoin", true);
-        }
-        if (modules.containsKey("ethereum") && modules["ethereum"].containsKey("cryptoId")) {
-            Serial.println("Requesting forced fetch for ethereum module");
-            scheduler.requestFetch("ethereum", true);
-        }
-        if (modules.containsKey("stock") && modules["stock"].containsKey("ticker")) {
-            Serial.println("Requesting forced fetch for stock module");
-            scheduler.requestFetch("stock", true);
-        }
-        if (modules.containsKey("weather") && modules["weather"].containsKey("location")) {
-            Serial.println("Requesting forced fetch for weather module");
-            scheduler.requestFetch("weather", true);
+    for (uint8_t i = 0; i < MODULE_COUNT; i++) {
+        if (refetch[i]) {
+            Serial.print("Requesting forced fetch for ");
+            Serial.print(moduleNames[i]);
+            Serial.println(" module");
+            scheduler.requestFetch((ModuleId)i, true);
         }
     }
 
@@ -964,6 +823,15 @@ void NetworkManager::handleStockSearch() {
     http.end();
 }
 
+void NetworkManager::handleMemStats() {
+    DynamicJsonDocument doc(1024);
+    exportMemStats(doc.to<JsonObject>());
+
+    String response;
+    serializeJson(doc, response);
+    server->send(200, "application/json", response);
+}
+
 void NetworkManager::handleRestart() {
     // Check authorization
     String token = server->header("Authorization");
@@ -973,6 +841,7 @@ void NetworkManager::handleRestart() {
     }
 
     server->send(200, "application/json", "{\"success\":true}");
+    saveCacheSnapshot(true);
     delay(500);
     ESP.restart();
 }
@@ -0,0 +1,75 @@
+#include "profiler.h"
+
+static const char* const stageNames[PERF_STAGE_COUNT] = {
+    "serial", "button", "web", "scheduler", "snapshot", "display", "loop"
+};
+
+static PerfStats stageStats[PERF_STAGE_COUNT];
+static uint32_t loopStart = 0;
+static uint32_t lapStart = 0;
+
+static void record(PerfStage stage, uint32_t cycles) {
+    PerfStats& stats = stageStats[stage];
+    if (stats.count == 0 || cycles < stats.minCycles) stats.minCycles = cycles;
+    if (cycles > stats.maxCycles) stats.maxCycles = cycles;
+    stats.totalCycles += cycles;
+    stats.count++;
+
+    uint32_t micros = perfCyclesToMicros(cycles);
+    uint8_t bucket = 0;
+    while (micros > 0 && bucket < PERF_BUCKETS - 1) {
+        micros >>= 1;
+        bucket++;
+    }
+    stats.buckets[bucket]++;
+}
+
+void perfBeginLoop() {
+    loopStart = ESP.getCycleCount();
+    lapStart = loopStart;
+}
+
+void perfLap(PerfStage stage) {
+    // Unsigned difference survives the 32-bit counter wrapping (~27 s at 160 MHz)
+    uint32_t now = ESP.getCycleCount();
+    record(stage, now - lapStart);
+    lapStart = now;
+}
+
+void perfEndLoop() {
+    record(PERF_LOOP, lapStart - loopStart);
+}
+
+void perfReset() {
+    memset(stageStats, 0, sizeof(stageStats));
+}
+
+const PerfStats& perfStats(PerfStage stage) {
+    return stageStats[stage];
+}
+
+const char* perfStageName(PerfStage stage) {
+    return stage < PERF_STAGE_COUNT ? stageNames[stage] : "unknown";
+}
+
+uint32_t perfCyclesToMicros(uint64_t cycles) {
+    return (uint32_t)(cycles / ESP.getCpuFreqMHz());
+}
+
+uint32_t perfPercentileMicros(PerfStage stage, uint8_t percentile) {
+    const PerfStats& stats = stageStats[stage];
+    if (stats.count == 0) return 0;
+
+    // Smallest bucket edge with at least percentile% of samples at or below it
+    uint64_t target = ((uint64_t)stats.count * percentile + 99) / 100;
+    uint64_t seen = 0;
+    uint32_t maxMicros = perfCyclesToMicros(stats.maxCycles);
+    for (uint8_t i = 0; i < PERF_BUCKETS; i++) {
+        seen += stats.buckets[i];
+        if (seen >= target) {
+            uint32_t edge = (i == PERF_BUCKETS - 1) ? maxMicros : (1UL << i);
+            return min(edge, maxMicros);
+        }
+    }
+    return maxMicros;
+}
@@ -1,93 +1,215 @@
 #include "scheduler.h"
 #include "modules/module_interface.h"
 #include "config.h"
+#include "memstats.h"
+#include <WiFi.h>
+#include <algorithm>
+
+// Upstream request budgets (free tiers, shared by every module on the host)
+static const HostLimit hostLimits[] = {
+    { "api.coingecko.com",        3, 20 },
+    { "query1.finance.yahoo.com", 2, 30 },
+    { "api.open-meteo.com",       3, 10 },
+    { nullptr,                    2, 30 }   // Anything else
+};
 
 Scheduler::Scheduler() {
     context.state = IDLE;
-    context.lastFetchTime = 0;
+    context.lastFetchTime = TIME_NEVER;
     context.nextAllowedFetch = 0;
-    context.retryCount = 0;
-    context.retryDelay = 0;
-    lastGlobalFetch = 0;
-}
-
-Scheduler::~Scheduler() {
-    // Clean up registered modules
-    for (auto& pair : modules) {
-        delete pair.second;
+    context.forced = false;
+    context.currentModule = MODULE_NONE;
+    memset(backoff, 0, sizeof(backoff));
+    memset(moduleStats, 0, sizeof(moduleStats));
+    static_assert(sizeof(hostLimits) / sizeof(hostLimits[0]) == HOST_LIMIT_COUNT, "one bucket per host limit");
+    for (uint8_t i = 0; i < HOST_LIMIT_COUNT; i++) {
+        buckets[i] = { &hostLimits[i], (float)hostLimits[i].burst, 0, 0 };
     }
-    modules.clear();
+    lastGlobalFetch = TIME_NEVER;
+    pendingCount = 0;
+    batchCount = 0;
+    refreshCount = 0;
+    queueDirty = true;
+    queuedActive = MODULE_NONE;
+    queuedInterval = 0;
+    backgroundCount = 0;
 }
 
 void Scheduler::init() {
-    Serial.println("Scheduler initialized");
-}
-
-void Scheduler::registerModule(ModuleInterface* module) {
-    if (module && module->id) {
-        modules[String(module->id)] = module;
-        Serial.print("Registered module: ");
-        Serial.println(module->id);
-    }
+    Serial.print("Scheduler initialized with ");
+    Serial.print(MODULE_COUNT);
+    Serial.println(" modules");
 }
 
 void Scheduler::tick() {
-    unsigned long now = millis() / 1000;
+    uint64_t now = uptimeSeconds();
 
-    // If currently fetching, let it complete
+    // If currently fetching, advance the request by one slice
     if (context.state == FETCHING) {
+        pollFetch();
+        return;
+    }
+
+    // Close a connection whose request gave up while it was being opened
+    fetcher.closeAbandoned();
+
+    // Run forced fetches that were queued behind the last one
+    if (pendingCount > 0) {
+        ModuleId id = pendingFetches[0];
+        pendingCount--;
+        for (uint8_t i = 0; i < pendingCount; i++) {
+            pendingFetches[i] = pendingFetches[i + 1];
+        }
+        requestFetch(id, true);
+        return;
+    }
+
+    // Restored readings look never-updated until they are dated; refreshing
+    // now would refetch everything right after a reboot
+    if (cacheRestorePending()) {
         return;
     }
 
     // Check if it's time to auto-refresh the active module
     if (context.state == IDLE) {
-        String activeModule = config["device"]["activeModule"] | "bitcoin";
+        ModuleId activeModule = getActiveModule();
         uint16_t refreshInterval = config["device"]["refreshInterval"] | 300;
 
-        JsonObject moduleData = config["modules"][activeModule];
-        unsigned long lastUpdate = moduleData["lastUpdate"] | 0;
+        // Modules without a cache record (settings) have nothing to refresh
+        ModuleCacheEntry* entry = getModuleCache(activeModule);
+        bool activeWaiting = backoff[activeModule].retryAt > now;
+        if (entry && !activeWaiting && timeSince(entry->lastUpdate, now) >= refreshInterval) {
+            // Time to refresh (wait out the global gap quietly rather than retry every tick)
+            if (!isCoolingDown(now)) {
+                requestFetch(activeModule, false);
+            }
+            return;
+        }
 
-        if (lastUpdate == 0 || (now - lastUpdate) >= refreshInterval) {
-            // Time to refresh
-            requestFetch(activeModule.c_str(), false);
+        // Active module is fresh or backing off: refresh whichever other module is due first
+        if (queueDirty || queuedInterval != refreshInterval || queuedActive != activeModule) {
+            buildRefreshQueue(activeModule, refreshInterval);
         }
+        if (refreshCount == 0 || refreshQueue[0].deadline > now) {
+            return;
+        }
+        if (!WiFi.isConnected() || isCoolingDown(now)) {
+            return;
+        }
+
+        ModuleId id = refreshQueue[0].module;
+        Serial.print("Background refresh: ");
+        Serial.println(moduleName(id));
+        backgroundCount++;
+        requestFetch(id, false);
     }
 }
 
-void Scheduler::requestFetch(const char* moduleId, bool forced) {
-    unsigned long now = millis() / 1000;
+// Global gap between any two fetches still running (requestFetch() would deny)
+bool Scheduler::isCoolingDown(uint64_t now) {
+    return timeSince(lastGlobalFetch, now) < GLOBAL_MIN_INTERVAL;
+}
+
+static bool laterDeadline(const RefreshEntry& a, const RefreshEntry& b) {
+    return a.deadline > b.deadline;
+}
+
+void Scheduler::buildRefreshQueue(ModuleId activeModule, uint16_t refreshInterval) {
+    // The module the button switches to next is kept as fresh as the active
+    // one; the rest only need to stay clear of isCacheStale()
+    ModuleId nextModule = MODULE_NONE;
+    int active = -1;
+    for (int i = 0; i < MODULE_CYCLE_COUNT; i++) {
+        if (moduleCycleOrder[i] == activeModule) {
+            active = i;
+            break;
+        }
+    }
+    for (int i = 1; i < MODULE_CYCLE_COUNT && nextModule == MODULE_NONE; i++) {
+        ModuleId id = moduleCycleOrder[(active + i + MODULE_CYCLE_COUNT) % MODULE_CYCLE_COUNT];
+        if (getModuleCache(id) && moduleTable[id]->defaultRefreshInterval > 0) {
+            nextModule = id;
+        }
+    }
+
+    unsigned long staleAge = (unsigned long)refreshInterval * 2;
+    unsigned long backgroundLimit = staleAge > STALE_MARGIN ? staleAge - STALE_MARGIN : 0;
+
+    refreshCount = 0;
+    for (uint8_t i = 0; i < MODULE_COUNT; i++) {
+        ModuleId id = (ModuleId)i;
+        ModuleInterface* module = moduleTable[id];
+        ModuleCacheEntry* entry = getModuleCache(id);
+
+        // Active module is handled by tick(); manual modules never auto-refresh
+        if (!entry || id == activeModule || module->defaultRefreshInterval == 0) continue;
+
+        unsigned long interval;
+        if (id == nextModule) {
+            interval = refreshInterval;
+        } else {
+            interval = min((unsigned long)module->defaultRefreshInterval, backgroundLimit);
+        }
+
+        // Never before requestFetch() would allow it
+        uint64_t deadline = 0;
+        if (entry->lastUpdate != TIME_NEVER) {
+            deadline = entry->lastUpdate + max(interval, (unsigned long)module->minRefreshInterval);
+        }
+        deadline = max(deadline, backoff[id].retryAt);
+
+        refreshQueue[refreshCount++] = { deadline, id };
+    }
+    std::make_heap(refreshQueue, refreshQueue + refreshCount, laterDeadline);
+
+    queuedActive = activeModule;
+    queuedInterval = refreshInterval;
+    queueDirty = false;
+}
+
+void Scheduler::requestFetch(ModuleId id, bool forced) {
+    uint64_t now = uptimeSeconds();
 
     // Check if module exists
-    if (modules.find(String(moduleId)) == modules.end()) {
-        Serial.print("ERROR: Module not found: ");
-        Serial.println(moduleId);
+    if (id >= MODULE_COUNT) {
+        Serial.println("ERROR: Module not found");
         return;
     }
 
-    ModuleInterface* module = modules[String(moduleId)];
+    ModuleInterface* module = moduleTable[id];
+
+    // Only one request in flight; forced fetches wait their turn
+    if (context.state == FETCHING) {
+        if (forced) {
+            queuePending(id);
+        } else {
+            Serial.println("Fetch denied: fetch in progress");
+        }
+        return;
+    }
 
     // Check global cooldown
-    if (!forced && (now - lastGlobalFetch) < GLOBAL_MIN_INTERVAL) {
+    if (!forced && isCoolingDown(now)) {
         Serial.println("Fetch denied: global cooldown active");
         return;
     }
 
     // Check module-specific cooldown
-    JsonObject moduleData = config["modules"][moduleId];
-    unsigned long lastUpdate = moduleData["lastUpdate"] | 0;
-    if (!forced && (now - lastUpdate) < module->minRefreshInterval) {
+    ModuleCacheEntry* entry = getModuleCache(id);
+    uint64_t sinceUpdate = timeSince(entry ? entry->lastUpdate : TIME_NEVER, now);
+    if (!forced && sinceUpdate < module->minRefreshInterval) {
         Serial.print("Fetch denied: module cooldown (last update ");
-        Serial.print(now - lastUpdate);
+        Serial.print((unsigned long)sinceUpdate);
         Serial.print("s ago, min interval ");
         Serial.print(module->minRefreshInterval);
         Serial.println("s)");
         return;
     }
 
-    // Check retry backoff (unless forced)
-    if (!forced && context.retryDelay > 0 && (now - context.lastFetchTime) < context.retryDelay) {
+    // Check this module's retry backoff (unless forced)
+    if (!forced && backoff[id].retryAt > now) {
         Serial.print("Fetch denied: retry backoff (");
-        Serial.print(context.retryDelay - (now - context.lastFetchTime));
+        Serial.print((unsigned long)(backoff[id].retryAt - now));
         Serial.println("s remaining)");
         return;
     }
@@ -96,58 +218,302 @@ void Scheduler::requestFetch(const char* moduleId, bool forced) {
     if (forced) {
         Serial.println("FORCED FETCH - bypassing all cooldowns");
     }
-    context.currentModule = String(moduleId);
+    context.currentModule = id;
+    context.forced = forced;
     context.state = FETCHING;
     executeFetch();
 }
 
 void Scheduler::executeFetch() {
-    if (modules.find(context.currentModule) == modules.end()) {
-        context.state = IDLE;
+    ModuleInterface* module = moduleTable[context.currentModule];
+
+    Serial.print("Fetching data for: ");
+    Serial.println(moduleName(context.currentModule));
+
+    // Network modules: start the request and let tick() drive it
+    String url;
+    if (buildBatch(context.currentModule, url) || module->buildRequest(url)) {
+        // The filter is the union of every module the response is for
+        ModuleId single = context.currentModule;
+        const ModuleId* members = batchCount > 0 ? batchMembers : &single;
+        uint8_t count = batchCount > 0 ? batchCount : 1;
+        responseFilter.clear();
+        for (uint8_t i = 0; i < count; i++) {
+            moduleTable[members[i]]->responseFilter(responseFilter);
+        }
+
+        if (!fetcher.begin(url.c_str(), parseBody, this)) {
+            completeFetch(false, fetcher.getError());
+            return;
+        }
+
+        // Spend a token from the host's budget, or try again once one is due
+        uint64_t now = uptimeSeconds();
+        HostBucket& bucket = bucketFor(fetcher.getHost());
+        unsigned long wait = bucketWait(bucket, now, context.forced);
+        if (wait > 0) {
+            fetcher.abort();
+            batchCount = 0;
+            Serial.print("Fetch deferred: ");
+            Serial.print(fetcher.getHost());
+            Serial.print(" rate limit (");
+            Serial.print(wait);
+            Serial.println("s)");
+            deferFetch(context.currentModule, now + wait);
+            context.state = IDLE;
+            return;
+        }
+        bucket.tokens -= 1;
         return;
     }
 
-    ModuleInterface* module = modules[context.currentModule];
+    // Local modules complete immediately
+    String errorMsg;
+    bool success = module->fetch(errorMsg);
+    completeFetch(success, errorMsg);
+}
 
-    Serial.print("Fetching data for: ");
-    Serial.println(context.currentModule);
+void Scheduler::pollFetch() {
+    FetchState fetchState = fetcher.poll();
+    memSample(MEM_STAGE_FETCH);
+    if (fetchState != FETCH_DONE && fetchState != FETCH_FAILED) {
+        return;
+    }
 
+    bool success = false;
+    bool memberOk[MAX_BATCH] = {};
     String errorMsg;
-    bool success = module->fetch(errorMsg);
 
-    unsigned long now = millis() / 1000;
+    if (fetchState == FETCH_FAILED) {
+        errorMsg = fetcher.getError();
+    } else if (fetcher.getStatusCode() == 429) {
+        // Server-side limit: stop using this host until it says so
+        uint64_t now = uptimeSeconds();
+        long retryAfter = fetcher.getRetryAfter();
+        HostBucket& bucket = bucketFor(fetcher.getHost());
+        bucket.tokens = 0;
+        bucket.blockedUntil = now + (retryAfter >= 0 ? retryAfter : DEFAULT_RETRY_AFTER);
+        errorMsg = "HTTP 429, retry after " + String((unsigned long)(bucket.blockedUntil - now)) + "s";
+    } else if (fetcher.getStatusCode() != 200) {
+        errorMsg = "HTTP " + String(fetcher.getStatusCode());
+    } else {
+        success = readResponse(errorMsg, memberOk);
+    }
+    memSample(MEM_STAGE_FETCH);
+
+    // Every module the request was for shares its time. completeFetch()
+    // counts the requested module; the other batch members are counted
+    // here, and a fresh reading clears their backoff too.
+    uint32_t elapsed = fetcher.getElapsed();
+    ModuleId single = context.currentModule;
+    const ModuleId* members = batchCount > 0 ? batchMembers : &single;
+    uint8_t count = batchCount > 0 ? batchCount : 1;
+    for (uint8_t i = 0; i < count; i++) {
+        ModuleFetchStats& timing = moduleStats[members[i]];
+        timing.lastMs = elapsed;
+        timing.totalMs += elapsed;
+        timing.timed++;
+        if (i == 0) continue;
+
+        timing.fetches++;
+        if (!memberOk[i]) {
+            timing.failures++;
+            continue;
+        }
+        backoff[members[i]].retryCount = 0;
+        backoff[members[i]].retryAt = 0;
+    }
+    batchCount = 0;
+
+    const FetchStats& stats = fetcher.getStats();
+    Serial.print("Request took ");
+    Serial.print(elapsed);
+    Serial.print(" ms, ");
+    Serial.print(stats.lastRequestBytes);
+    Serial.println(" bytes");
+
+    completeFetch(success, errorMsg);
+}
+
+void Scheduler::completeFetch(bool success, const String& errorMsg) {
+    uint64_t now = uptimeSeconds();
     context.lastFetchTime = now;
     lastGlobalFetch = now;
+    queueDirty = true;  // Readings (possibly several, if batched) changed
+
+    ModuleBackoff& moduleBackoff = backoff[context.currentModule];
+    ModuleCacheEntry* entry = getModuleCache(context.currentModule);
+    moduleStats[context.currentModule].fetches++;
 
     if (success) {
         Serial.println("Fetch successful");
-        context.retryCount = 0;
-        context.retryDelay = 0;
+        moduleBackoff.retryCount = 0;
+        moduleBackoff.retryAt = 0;
 
-        JsonObject moduleData = config["modules"][context.currentModule];
-        moduleData["lastSuccess"] = true;
+        if (entry) entry->lastSuccess = true;
     } else {
         Serial.print("Fetch failed: ");
         Serial.println(errorMsg);
+        moduleStats[context.currentModule].failures++;
 
-        context.retryCount++;
-        context.retryDelay = calculateBackoff(context.retryCount);
+        if (entry) entry->lastSuccess = false;
 
-        JsonObject moduleData = config["modules"][context.currentModule];
-        moduleData["lastSuccess"] = false;
+        // Only this module backs off; others keep their schedule
+        if (moduleBackoff.retryCount < 255) moduleBackoff.retryCount++;
+        uint16_t delay = calculateBackoff(moduleBackoff.retryCount);
+        moduleBackoff.retryAt = max(moduleBackoff.retryAt, now + delay);
 
         Serial.print("Retry count: ");
-        Serial.print(context.retryCount);
+        Serial.print(moduleBackoff.retryCount);
         Serial.print(", next retry in ");
-        Serial.print(context.retryDelay);
+        Serial.print((unsigned long)(moduleBackoff.retryAt - now));
         Serial.println(" seconds");
     }
 
     context.state = IDLE;
 }
 
+bool Scheduler::buildBatch(ModuleId id, String& url) {
+    batchCount = 0;
+    ModuleInterface* module = moduleTable[id];
+    const char* key = module->batchKey();
+    if (!key) return false;
+
+    // Requested module first so its parse result decides success
+    batchMembers[batchCount++] = id;
+    String params = module->batchParam();
+
+    for (uint8_t i = 0; i < MODULE_COUNT; i++) {
+        ModuleInterface* other = moduleTable[i];
+        if (i == id || batchCount >= MAX_BATCH) continue;
+        const char* otherKey = other->batchKey();
+        if (!otherKey || strcmp(otherKey, key) != 0) continue;
+
+        batchMembers[batchCount++] = (ModuleId)i;
+        String param = other->batchParam();
+        if (("," + params + ",").indexOf("," + param + ",") < 0) {
+            params += "," + param;
+        }
+    }
+
+    if (!module->buildBatchRequest(params, url)) {
+        batchCount = 0;
+        return false;
+    }
+
+    if (batchCount > 1) {
+        Serial.print("Batched ");
+        Serial.print(batchCount);
+        Serial.print(" modules: ");
+        Serial.println(params);
+    }
+    return true;
+}
+
+bool Scheduler::readResponse(String& errorMsg, bool* parsed) {
+    // Every module the response is for: the batch, or just the one fetched
+    ModuleId single = context.currentModule;
+    const ModuleId* members = batchCount > 0 ? batchMembers : &single;
+    uint8_t count = batchCount > 0 ? batchCount : 1;
+
+    if (parseError) {
+        errorMsg = "JSON parse error: " + String(parseError.c_str());
+        return false;
+    }
+
+    for (uint8_t i = 0; i < count; i++) {
+        ModuleId member = members[i];
+        String memberError;
+        parsed[i] = moduleTable[member]->readResponse(responseDoc.as<JsonVariantConst>(), memberError);
+
+        if (i == 0) {
+            // The requested module goes through the normal bookkeeping
+            errorMsg = memberError;
+        } else if (parsed[i]) {
+            // Already fresh; a queued forced fetch would only repeat this request
+            removePending(member);
+        } else {
+            Serial.print("Batch update failed for ");
+            Serial.print(moduleName(member));
+            Serial.print(": ");
+            Serial.println(memberError);
+        }
+    }
+
+    return parsed[0];
+}
+
+void Scheduler::parseBody(Stream& body, void* arg) {
+    // Runs on the fetcher's body task: the JSON is parsed from the socket as
+    // it arrives, keeping only what the filter asks for
+    Scheduler* scheduler = static_cast<Scheduler*>(arg);
+    scheduler->parseError = deserializeJson(scheduler->responseDoc, body,
+                                            DeserializationOption::Filter(scheduler->responseFilter));
+}
+
+void Scheduler::removePending(ModuleId id) {
+    for (uint8_t i = 0; i < pendingCount; i++) {
+        if (pendingFetches[i] == id) {
+            pendingCount--;
+            for (uint8_t j = i; j < pendingCount; j++) {
+                pendingFetches[j] = pendingFetches[j + 1];
+            }
+            return;
+        }
+    }
+}
+
+void Scheduler::queuePending(ModuleId id) {
+    for (uint8_t i = 0; i < pendingCount; i++) {
+        if (pendingFetches[i] == id) {
+            return;  // Already queued
+        }
+    }
+    if (pendingCount >= MAX_PENDING) {
+        Serial.println("Fetch denied: pending queue full");
+        return;
+    }
+    pendingFetches[pendingCount++] = id;
+    Serial.print("Fetch queued: ");
+    Serial.println(moduleName(id));
+}
+
 uint16_t Scheduler::calculateBackoff(uint8_t retryCount) {
-    // Exponential backoff: min(2^n × 60s, 3600s)
-    uint16_t delay = 60 * (1 << retryCount);  // 2^n × 60
-    return min(delay, (uint16_t)3600);
+    // Exponential backoff: min(2^n × 60s, 3600s), then jittered to 50-100%
+    // so devices that failed together do not retry together
+    uint16_t delay = (retryCount >= 6) ? 3600 : min(60 * (1 << retryCount), 3600);
+    return delay / 2 + random(delay / 2 + 1);
+}
+
+HostBucket& Scheduler::bucketFor(const String& host) {
+    for (uint8_t i = 0; i < HOST_LIMIT_COUNT - 1; i++) {
+        if (host == buckets[i].limit->host) {
+            return buckets[i];
+        }
+    }
+    return buckets[HOST_LIMIT_COUNT - 1];
+}
+
+// Seconds until the host accepts another request (0 = now). Forced fetches
+// skip the local budget but still honor a server's Retry-After.
+unsigned long Scheduler::bucketWait(HostBucket& bucket, uint64_t now, bool forced) {
+    if (bucket.blockedUntil > now) {
+        return bucket.blockedUntil - now;
+    }
+
+    const HostLimit& limit = *bucket.limit;
+    bucket.tokens = min((float)limit.burst, bucket.tokens + (float)(now - bucket.lastRefill) / limit.refillSeconds);
+    bucket.lastRefill = now;
+
+    if (forced || bucket.tokens >= 1) {
+        if (bucket.tokens < 1) bucket.tokens = 1;  // Forced: allowed on an empty bucket
+        return 0;
+    }
+    return (unsigned long)ceil((1 - bucket.tokens) * limit.refillSeconds);
+}
+
+// Push a module's next attempt back without counting a failure
+void Scheduler::deferFetch(ModuleId id, uint64_t retryAt) {
+    backoff[id].retryAt = max(backoff[id].retryAt, retryAt);
+    queueDirty = true;
 }
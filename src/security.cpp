@@ -10,7 +10,7 @@ SecurityManager::SecurityManager() {
     randomSeed(millis());
 
     currentCode.code = 0;
-    currentCode.generatedAt = 0;
+    currentCode.generatedAt = TIME_NEVER;
     currentCode.used = false;
     currentCode.failedAttempts = 0;
     currentCode.lockoutUntil = 0;
@@ -23,7 +23,7 @@ SecurityManager::SecurityManager() {
 uint32_t SecurityManager::generateNewCode() {
     // Reset previous code state
     currentCode.code = random(100000, 999999);  // 6-digit code
-    currentCode.generatedAt = millis();
+    currentCode.generatedAt = uptimeMillis();
     currentCode.used = false;
     currentCode.failedAttempts = 0;
     currentCode.lockoutUntil = 0;
@@ -35,16 +35,16 @@ uint32_t SecurityManager::generateNewCode() {
 }
 
 bool SecurityManager::validateCode(uint32_t enteredCode) {
-    unsigned long now = millis();
+    uint64_t now = uptimeMillis();
 
     // Check if locked out
-    if (now < currentCode.lockoutUntil) {
+    if (!timeReached(currentCode.lockoutUntil, now)) {
         Serial.println("Code validation failed: locked out");
         return false;
     }
 
     // Check expiration (5 minutes)
-    if (now - currentCode.generatedAt > CODE_EXPIRATION_MS) {
+    if (timeSince(currentCode.generatedAt, now) > CODE_EXPIRATION_MS) {
         Serial.println("Code validation failed: expired");
         return false;
     }
@@ -78,15 +78,15 @@ bool SecurityManager::validateCode(uint32_t enteredCode) {
 }
 
 bool SecurityManager::isCodeValid() {
-    unsigned long now = millis();
+    uint64_t now = uptimeMillis();
 
     // Check if locked out
-    if (now < currentCode.lockoutUntil) {
+    if (!timeReached(currentCode.lockoutUntil, now)) {
         return false;
     }
 
     // Check expiration
-    if (now - currentCode.generatedAt > CODE_EXPIRATION_MS) {
+    if (timeSince(currentCode.generatedAt, now) > CODE_EXPIRATION_MS) {
         return false;
     }
 
@@ -107,7 +107,7 @@ unsigned long SecurityManager::getCodeTimeRemaining() {
         return 0;
     }
 
-    unsigned long elapsed = millis() - currentCode.generatedAt;
+    uint64_t elapsed = timeSince(currentCode.generatedAt, uptimeMillis());
     if (elapsed >= CODE_EXPIRATION_MS) {
         return 0;
     }
@@ -116,7 +116,7 @@ unsigned long SecurityManager::getCodeTimeRemaining() {
 }
 
 bool SecurityManager::isLockedOut() {
-    return millis() < currentCode.lockoutUntil;
+    return !timeReached(currentCode.lockoutUntil, uptimeMillis());
 }
 
 unsigned long SecurityManager::getLockoutTimeRemaining() {
@@ -124,7 +124,7 @@ unsigned long SecurityManager::getLockoutTimeRemaining() {
         return 0;
     }
 
-    return currentCode.lockoutUntil - millis();
+    return (unsigned long)(currentCode.lockoutUntil - uptimeMillis());
 }
 
 String SecurityManager::createSession() {
@@ -137,7 +137,7 @@ String SecurityManager::createSession() {
 
     // Store session
     strncpy(currentSession.token, token, 33);
-    currentSession.expiresAt = millis() + SESSION_EXPIRATION_MS;
+    currentSession.expiresAt = uptimeMillis() + SESSION_EXPIRATION_MS;
     currentSession.active = true;
 
     Serial.print("Session created: ");
@@ -152,13 +152,13 @@ bool SecurityManager::validateSession(const String& token) {
         return false;
     }
 
-    if (millis() > currentSession.expiresAt) {
+    if (timeReached(currentSession.expiresAt, uptimeMillis())) {
         currentSession.active = false;
         Serial.println("Session validation failed: expired");
         return false;
     }
 
-    if (token != String(currentSession.token)) {
+    if (strcmp(token.c_str(), currentSession.token) != 0) {
         Serial.println("Session validation failed: invalid token");
         return false;
     }
@@ -178,7 +178,7 @@ bool SecurityManager::isSessionActive() {
         return false;
     }
 
-    if (millis() > currentSession.expiresAt) {
+    if (timeReached(currentSession.expiresAt, uptimeMillis())) {
         currentSession.active = false;
         return false;
     }
@@ -191,12 +191,12 @@ unsigned long SecurityManager::getSessionTimeRemaining() {
         return 0;
     }
 
-    return currentSession.expiresAt - millis();
+    return (unsigned long)(currentSession.expiresAt - uptimeMillis());
 }
 
 void SecurityManager::resetCode() {
     currentCode.code = 0;
-    currentCode.generatedAt = 0;
+    currentCode.generatedAt = TIME_NEVER;
     currentCode.used = false;
     currentCode.failedAttempts = 0;
     currentCode.lockoutUntil = 0;
@@ -0,0 +1,68 @@
+#ifndef HOST_DEVICE_H
+#define HOST_DEVICE_H
+
+// Shared by the native tests that boot the whole firmware (src/ is built in
+// via test_build_src): a scratch LittleFS with a known config, canned API
+// responses and a fake clock that can start anywhere.
+
+#include <Arduino.h>
+#include <esp_timer.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+void setup();
+void loop();
+
+// WiFi configured, bitcoin active, 5 minute refresh
+#define HOST_TEST_CONFIG \
+    "{\"wifi\":{\"ssid\":\"Home\",\"password\":\"\"}," \
+    "\"device\":{\"activeModule\":\"bitcoin\",\"enableButton\":true,\"refreshInterval\":300}," \
+    "\"modules\":{" \
+    "\"bitcoin\":{\"cryptoId\":\"bitcoin\",\"cryptoSymbol\":\"BTC\",\"cryptoName\":\"Bitcoin\"}," \
+    "\"ethereum\":{\"cryptoId\":\"ethereum\",\"cryptoSymbol\":\"ETH\",\"cryptoName\":\"Ethereum\"}," \
+    "\"stock\":{\"ticker\":\"AAPL\",\"name\":\"Apple Inc.\"}," \
+    "\"weather\":{\"latitude\":37.7749,\"longitude\":-122.4194,\"location\":\"San Francisco\"}," \
+    "\"custom\":{\"label\":\"My Metric\",\"unit\":\"units\"}}}"
+#define HOST_TEST_REFRESH_S 300
+
+// Full 64-bit fake clock, unlike millis()
+static inline uint64_t hostNowMs() {
+    return (uint64_t)esp_timer_get_time() / 1000;
+}
+
+// Canned responses for every module's API; pass a latency above
+// FETCH_TIMEOUT_MS to make that module's fetches time out
+static inline void hostAddApiFixtures(unsigned long cryptoMs, unsigned long stockMs, unsigned long weatherMs) {
+    hostAddHttpResponse("https://api.coingecko.com/api/v3/simple/price", 200,
+                        "{\"bitcoin\":{\"usd\":67123.5,\"usd_24h_change\":1.25},"
+                        "\"ethereum\":{\"usd\":3456.7,\"usd_24h_change\":-0.5}}", cryptoMs);
+    hostAddHttpResponse("https://query1.finance.yahoo.com/", 200,
+                        "{\"quoteResponse\":{\"result\":[{\"symbol\":\"AAPL\","
+                        "\"regularMarketPrice\":190.1,\"regularMarketChangePercent\":0.4}]}}", stockMs);
+    hostAddHttpResponse("https://api.open-meteo.com/", 200,
+                        "{\"current_weather\":{\"temperature\":17.2,\"weathercode\":2}}", weatherMs);
+}
+
+// Fresh LittleFS directory holding config.json, then setup() at startMs
+static inline void hostBootDevice(const char* configJson, unsigned long startMs) {
+    char root[] = "/tmp/datatracker_test_XXXXXX";
+    if (!mkdtemp(root)) {
+        perror("mkdtemp");
+        exit(1);
+    }
+    String path = String(root) + "/config.json";
+    FILE* fp = fopen(path.c_str(), "w");
+    if (!fp) {
+        perror("config.json");
+        exit(1);
+    }
+    fputs(configJson, fp);
+    fclose(fp);
+
+    hostSetFsRoot(root);
+    hostSetMillis(startMs);
+    setup();
+    hostSetQuiet(true);
+}
+
+#endif // HOST_DEVICE_H
@@ -0,0 +1,175 @@
+// recognizeGesture() replayed on synthetic edge sequences, sampled every
+// BUTTON_SAMPLE_INTERVAL_US like the device's timer.
+
+#include <unity.h>
+#include "button.h"
+
+struct Edge {
+    uint32_t at;      // ms from the start of the sequence
+    bool touched;
+};
+
+struct Recorded {
+    ButtonEvent type;
+    uint32_t at;      // ms from the start of the sequence
+    uint32_t duration;
+};
+
+static const uint32_t SAMPLE_MS = BUTTON_SAMPLE_INTERVAL_US / 1000;
+static const uint8_t MAX_RECORDED = 32;
+static Recorded recorded[MAX_RECORDED];
+static uint8_t recordedCount;
+
+// Samples the edge sequence from base until untilMs, recording each event
+static void replay(const Edge* edges, size_t count, uint32_t untilMs, uint32_t base = 0) {
+    GestureState state = {};
+    state.lastChange = base;
+    recordedCount = 0;
+
+    bool touched = false;
+    size_t next = 0;
+    for (uint32_t t = 0; t <= untilMs; t += SAMPLE_MS) {
+        while (next < count && edges[next].at <= t) {
+            touched = edges[next++].touched;
+        }
+        uint32_t duration;
+        ButtonEvent event = recognizeGesture(state, touched, base + t, duration);
+        if (event != NONE && recordedCount < MAX_RECORDED) {
+            recorded[recordedCount++] = { event, t, duration };
+        }
+    }
+}
+
+#define REPLAY(edges, untilMs) replay(edges, sizeof(edges) / sizeof(edges[0]), untilMs)
+
+// A press edge is taken once the level has held for DEBOUNCE_DELAY
+static const uint32_t SETTLE_MS = DEBOUNCE_DELAY + SAMPLE_MS;
+
+void setUp() {}
+void tearDown() {}
+
+void test_single_tap() {
+    const Edge edges[] = { { 100, true }, { 250, false } };
+    REPLAY(edges, 2000);
+
+    TEST_ASSERT_EQUAL_UINT8(1, recordedCount);
+    TEST_ASSERT_EQUAL(SHORT_PRESS, recorded[0].type);
+    TEST_ASSERT_EQUAL_UINT32(150, recorded[0].duration);
+    // Only reported once the double-tap window has passed
+    TEST_ASSERT_UINT32_WITHIN(SAMPLE_MS, 250 + SETTLE_MS + DOUBLE_TAP_WINDOW, recorded[0].at);
+}
+
+void test_double_tap() {
+    const Edge edges[] = { { 100, true }, { 250, false }, { 400, true }, { 520, false } };
+    REPLAY(edges, 2000);
+
+    TEST_ASSERT_EQUAL_UINT8(1, recordedCount);
+    TEST_ASSERT_EQUAL(DOUBLE_TAP, recorded[0].type);
+    TEST_ASSERT_EQUAL_UINT32(120, recorded[0].duration);
+    TEST_ASSERT_EQUAL_UINT32(520 + SETTLE_MS, recorded[0].at);
+}
+
+void test_taps_too_far_apart_are_two_single_taps() {
+    const Edge edges[] = { { 100, true }, { 250, false }, { 1000, true }, { 1150, false } };
+    REPLAY(edges, 3000);
+
+    TEST_ASSERT_EQUAL_UINT8(2, recordedCount);
+    TEST_ASSERT_EQUAL(SHORT_PRESS, recorded[0].type);
+    TEST_ASSERT_EQUAL(SHORT_PRESS, recorded[1].type);
+}
+
+void test_tap_then_hold_repeats() {
+    // Second press held for 2 s: first repeat after HOLD_REPEAT_DELAY, then
+    // one every HOLD_REPEAT_INTERVAL until release, and nothing after it
+    const Edge edges[] = { { 100, true }, { 250, false }, { 400, true }, { 2400, false } };
+    REPLAY(edges, 4000);
+
+    uint32_t firstRepeat = 400 + SETTLE_MS + HOLD_REPEAT_DELAY;
+    uint32_t release = 2400 + SETTLE_MS;
+    uint8_t expected = 1 + (release - firstRepeat - 1) / HOLD_REPEAT_INTERVAL;
+    TEST_ASSERT_EQUAL_UINT8(expected, recordedCount);
+    for (uint8_t i = 0; i < recordedCount; i++) {
+        TEST_ASSERT_EQUAL(REPEAT_PRESS, recorded[i].type);
+        TEST_ASSERT_EQUAL_UINT32(firstRepeat + i * HOLD_REPEAT_INTERVAL, recorded[i].at);
+        TEST_ASSERT_EQUAL_UINT32(recorded[i].at - (400 + SETTLE_MS), recorded[i].duration);
+    }
+}
+
+void test_long_press() {
+    const Edge edges[] = { { 100, true }, { 4100, false } };
+    REPLAY(edges, 6000);
+
+    TEST_ASSERT_EQUAL_UINT8(1, recordedCount);
+    TEST_ASSERT_EQUAL(LONG_PRESS, recorded[0].type);
+    TEST_ASSERT_EQUAL_UINT32(4000, recorded[0].duration);
+    // Reported on release, not while held
+    TEST_ASSERT_EQUAL_UINT32(4100 + SETTLE_MS, recorded[0].at);
+}
+
+void test_factory_reset_hold() {
+    const Edge edges[] = { { 100, true }, { 100 + FACTORY_RESET_MIN + 500, false } };
+    REPLAY(edges, FACTORY_RESET_MIN + 2000);
+
+    TEST_ASSERT_EQUAL_UINT8(1, recordedCount);
+    TEST_ASSERT_EQUAL(FACTORY_RESET, recorded[0].type);
+    TEST_ASSERT_EQUAL_UINT32(FACTORY_RESET_MIN + 500, recorded[0].duration);
+}
+
+void test_hold_between_tap_and_long_press_is_ignored() {
+    const Edge edges[] = { { 100, true }, { 2100, false } };
+    REPLAY(edges, 4000);
+
+    TEST_ASSERT_EQUAL_UINT8(0, recordedCount);
+}
+
+void test_bounce_alone_is_ignored() {
+    // Contact chatter that never settles for DEBOUNCE_DELAY
+    const Edge edges[] = {
+        { 100, true }, { 120, false }, { 140, true }, { 160, false },
+        { 180, true }, { 200, false }, { 220, true }, { 240, false }
+    };
+    REPLAY(edges, 2000);
+
+    TEST_ASSERT_EQUAL_UINT8(0, recordedCount);
+}
+
+void test_bouncy_tap_is_one_tap() {
+    // Chatter on both edges of a 300 ms press
+    const Edge edges[] = {
+        { 100, true }, { 110, false }, { 125, true }, { 135, false }, { 150, true },
+        { 450, false }, { 460, true }, { 470, false }, { 485, true }, { 495, false }
+    };
+    REPLAY(edges, 2000);
+
+    TEST_ASSERT_EQUAL_UINT8(1, recordedCount);
+    TEST_ASSERT_EQUAL(SHORT_PRESS, recorded[0].type);
+    TEST_ASSERT_EQUAL_UINT32(345, recorded[0].duration);
+}
+
+void test_repeat_across_millis_wrap() {
+    // Same tap-then-hold with the 32-bit clock wrapping during the hold
+    const Edge edges[] = { { 100, true }, { 250, false }, { 400, true }, { 2400, false } };
+    replay(edges, sizeof(edges) / sizeof(edges[0]), 4000, 0xFFFFFFFFUL - 1000);
+
+    uint32_t firstRepeat = 400 + SETTLE_MS + HOLD_REPEAT_DELAY;
+    TEST_ASSERT_GREATER_THAN_UINT32(1, recordedCount);
+    for (uint8_t i = 0; i < recordedCount; i++) {
+        TEST_ASSERT_EQUAL(REPEAT_PRESS, recorded[i].type);
+        TEST_ASSERT_EQUAL_UINT32(firstRepeat + i * HOLD_REPEAT_INTERVAL, recorded[i].at);
+    }
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_single_tap);
+    RUN_TEST(test_double_tap);
+    RUN_TEST(test_taps_too_far_apart_are_two_single_taps);
+    RUN_TEST(test_tap_then_hold_repeats);
+    RUN_TEST(test_long_press);
+    RUN_TEST(test_factory_reset_hold);
+    RUN_TEST(test_hold_between_tap_and_long_press_is_ignored);
+    RUN_TEST(test_bounce_alone_is_ignored);
+    RUN_TEST(test_bouncy_tap_is_one_tap);
+    RUN_TEST(test_repeat_across_millis_wrap);
+    return UNITY_END();
+}
@@ -0,0 +1,96 @@
+// millis() wraps after ~49.7 days. Boot just before the wrap and check the
+// device keeps time, times out requests and refreshes modules across it.
+
+#include <unity.h>
+#include "../host_device.h"
+#include "clock.h"
+#include "config.h"
+#include "scheduler.h"
+
+extern Scheduler scheduler;
+
+static const uint64_t WRAP_MS = 0x100000000ULL;
+static const uint64_t BOOT_MS = WRAP_MS - 25000;
+
+// Steps loop() until done() or maxMs of fake clock pass; uptimeMillis()
+// must follow the 64-bit fake clock exactly on every iteration
+template <typename Done>
+static bool runUntil(Done done, uint64_t maxMs) {
+    uint64_t end = hostNowMs() + maxMs;
+    while (hostNowMs() < end) {
+        loop();
+        TEST_ASSERT_EQUAL_UINT64(hostNowMs(), uptimeMillis());
+        if (done()) return true;
+    }
+    return false;
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_fetch_times_out_across_wrap() {
+    // Weather never answers in time; its fetch starts before the wrap
+    uint64_t started = 0;
+    bool failed = runUntil([&]() {
+        const SchedulerContext& context = scheduler.getContext();
+        if (!started && context.state == FETCHING && context.currentModule == MODULE_WEATHER) {
+            started = hostNowMs();
+        }
+        return scheduler.getModuleStats(MODULE_WEATHER).failures > 0;
+    }, 60000);
+
+    TEST_ASSERT_TRUE_MESSAGE(failed, "weather fetch never failed");
+    uint64_t failedAt = hostNowMs();
+    TEST_ASSERT_NOT_EQUAL(0, started);
+    TEST_ASSERT_LESS_THAN_UINT64(WRAP_MS, started);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT64(WRAP_MS, failedAt);
+    // Timed out once, after FETCH_TIMEOUT_MS plus at most a loop() or two
+    TEST_ASSERT_UINT64_WITHIN(50, FETCH_TIMEOUT_MS, failedAt - started);
+    TEST_ASSERT_EQUAL_UINT32(1, scheduler.getModuleStats(MODULE_WEATHER).failures);
+}
+
+void test_refresh_continues_after_wrap() {
+    uint32_t fetchesBefore = scheduler.getModuleStats(MODULE_BITCOIN).fetches;
+    uint64_t wrapSeconds = uptimeSeconds() - (hostNowMs() - WRAP_MS) / 1000;
+    TEST_ASSERT_EQUAL_UINT32(1, fetchesBefore);
+
+    runUntil([]() { return false; }, (HOST_TEST_REFRESH_S + 30) * 1000UL);
+
+    // The active module refreshed on schedule after the wrap, not never or
+    // in a loop
+    uint32_t fetches = scheduler.getModuleStats(MODULE_BITCOIN).fetches;
+    TEST_ASSERT_EQUAL_UINT32(fetchesBefore + 1, fetches);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT64(wrapSeconds, getModuleCache(MODULE_BITCOIN)->lastUpdate);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT64(HOST_TEST_REFRESH_S, getCacheAge(MODULE_BITCOIN));
+    TEST_ASSERT_FALSE(isCacheStale(MODULE_BITCOIN));
+}
+
+void test_cache_age_counts_across_wrap() {
+    // Stock was fetched before the wrap and is refreshed in the background;
+    // its age must never come out as a huge or negative-looking value
+    uint64_t age = getCacheAge(MODULE_STOCK);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT64(2 * HOST_TEST_REFRESH_S, age);
+
+    // Custom is local: once the scheduler is free a forced fetch completes
+    // at once, then its age has to grow with the clock
+    TEST_ASSERT_TRUE(runUntil([]() { return scheduler.getState() == IDLE; }, 60000));
+    scheduler.requestFetch(MODULE_CUSTOM, true);
+    TEST_ASSERT_NOT_EQUAL(TIME_NEVER, getModuleCache(MODULE_CUSTOM)->lastUpdate);
+
+    uint64_t before = getCacheAge(MODULE_CUSTOM);
+    uint64_t until = uptimeSeconds() + 5;
+    TEST_ASSERT_TRUE(runUntil([&]() { return uptimeSeconds() >= until; }, 6000));
+    uint64_t after = getCacheAge(MODULE_CUSTOM);
+    TEST_ASSERT_EQUAL_UINT64(before + 5, after);
+}
+
+int main() {
+    hostAddApiFixtures(350, 500, FETCH_TIMEOUT_MS + 5000);
+    hostBootDevice(HOST_TEST_CONFIG, BOOT_MS);
+
+    UNITY_BEGIN();
+    RUN_TEST(test_fetch_times_out_across_wrap);
+    RUN_TEST(test_refresh_continues_after_wrap);
+    RUN_TEST(test_cache_age_counts_across_wrap);
+    return UNITY_END();
+}
@@ -0,0 +1,66 @@
+// An idle loop() (no fetch, web request, button press or snapshot due)
+// must not touch the heap: every iteration of a quiet window is checked
+// against the host's operator new counter.
+
+#include <unity.h>
+#include "../host_device.h"
+#include "display.h"
+#include "scheduler.h"
+#include <stdio.h>
+
+extern Scheduler scheduler;
+extern DisplayManager display;
+
+// Boot fetches (one every GLOBAL_MIN_INTERVAL) are done well before this,
+// and the first refresh and snapshot come well after the window
+static const uint64_t IDLE_FROM_MS = 60000;
+static const uint64_t IDLE_UNTIL_MS = (HOST_TEST_REFRESH_S - 10) * 1000UL;
+
+void setUp() {}
+void tearDown() {}
+
+void test_boot_fetches_settle() {
+    while (hostNowMs() < IDLE_FROM_MS) {
+        loop();
+    }
+    TEST_ASSERT_EQUAL(IDLE, scheduler.getState());
+    TEST_ASSERT_GREATER_THAN_UINT32(0, scheduler.getModuleStats(MODULE_BITCOIN).fetches);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, scheduler.getModuleStats(MODULE_WEATHER).fetches);
+}
+
+void test_idle_loop_does_not_allocate() {
+    unsigned long requests = hostHttpRequestCount();
+    DisplayStats framesBefore = display.getStats();
+    uint32_t iterations = 0;
+
+    while (hostNowMs() < IDLE_UNTIL_MS) {
+        unsigned long before = hostHeapAllocations();
+        uint64_t at = hostNowMs();
+        loop();
+        unsigned long allocations = hostHeapAllocations() - before;
+        if (allocations != 0) {
+            char message[80];
+            snprintf(message, sizeof(message), "%lu allocations in loop() at %llu ms",
+                     allocations, (unsigned long long)at);
+            TEST_FAIL_MESSAGE(message);
+        }
+        iterations++;
+    }
+
+    // The window really was idle, and the display path still ran in it
+    TEST_ASSERT_EQUAL_UINT32(requests, hostHttpRequestCount());
+    TEST_ASSERT_EQUAL(IDLE, scheduler.getState());
+    const DisplayStats& frames = display.getStats();
+    TEST_ASSERT_GREATER_THAN_UINT32(0, (frames.frames + frames.skipped) - (framesBefore.frames + framesBefore.skipped));
+    TEST_ASSERT_GREATER_THAN_UINT32(1000, iterations);
+}
+
+int main() {
+    hostAddApiFixtures(350, 500, 300);
+    hostBootDevice(HOST_TEST_CONFIG, 0);
+
+    UNITY_BEGIN();
+    RUN_TEST(test_boot_fetches_settle);
+    RUN_TEST(test_idle_loop_does_not_allocate);
+    return UNITY_END();
+}